@@ -3,196 +3,967 @@
 #include <stdexcept>
 #include <utility>
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+#include <cstring>
+#include <iomanip>
+#include <span>
+#include <vector>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
-class binary_int
-{
-private:
-    int value_;
+#define BINARY_INT_BACKEND_RIPPLE 0
+#define BINARY_INT_BACKEND_KOGGE_STONE 1
+#define BINARY_INT_BACKEND_NATIVE 2
 
-    static int add(int a, int b)
+#ifndef BINARY_INT_BACKEND
+#ifdef NDEBUG
+#define BINARY_INT_BACKEND BINARY_INT_BACKEND_NATIVE
+#else
+#define BINARY_INT_BACKEND BINARY_INT_BACKEND_KOGGE_STONE
+#endif
+#endif
+
+// Repeats half-adds until the carry clears: up to one dependent iteration per bit.
+struct ripple_carry_backend
+{
+    template <typename Word>
+    static constexpr Word add(Word a, Word b)
     {
         while (b)
         {
-            int carry = a & b;
+            Word carry = a & b;
             a = a ^ b;
             b = carry << 1;
         }
         return a;
     }
 
-    static int negate(int a)
+    template <typename Word>
+    static constexpr Word multiply(Word a, Word b)
+    {
+        Word result = 0;
+        while (b)
+        {
+            if (b & 1)
+            {
+                result = add(result, a);
+            }
+            a <<= 1;
+            b >>= 1;
+        }
+        return result;
+    }
+};
+
+// Parallel-prefix adder: all carries are resolved in log2(bits) mask-and-shift steps.
+struct kogge_stone_backend
+{
+    template <typename Word>
+    static constexpr Word add(Word a, Word b)
+    {
+        Word generate = a & b;
+        Word propagate = a ^ b;
+        for (int shift = 1; shift < std::numeric_limits<Word>::digits; shift <<= 1)
+        {
+            generate |= propagate & (generate << shift);
+            propagate &= propagate << shift;
+        }
+        return (a ^ b) ^ (generate << 1);
+    }
+
+    // Partial products are accumulated in carry-save form (sum + carry) with 3:2 compressors,
+    // so only the final add propagates carries. The low bit of b becomes a mask via an arithmetic shift.
+    template <typename Word>
+    static constexpr Word multiply(Word a, Word b)
+    {
+        constexpr int top = std::numeric_limits<Word>::digits - 1;
+        Word sum = 0;
+        Word carry = 0;
+        while (b)
+        {
+            Word partial = a & static_cast<Word>(static_cast<std::make_signed_t<Word>>(b << top) >> top);
+            Word next_sum = sum ^ carry ^ partial;
+            carry = ((sum & carry) | (sum & partial) | (carry & partial)) << 1;
+            sum = next_sum;
+            a <<= 1;
+            b >>= 1;
+        }
+        return add(sum, carry);
+    }
+};
+
+struct native_backend
+{
+    template <typename Word>
+    static constexpr Word add(Word a, Word b)
+    {
+        return a + b;
+    }
+
+    template <typename Word>
+    static constexpr Word multiply(Word a, Word b)
+    {
+        return a * b;
+    }
+};
+
+#if BINARY_INT_BACKEND == BINARY_INT_BACKEND_RIPPLE
+using default_binary_int_backend = ripple_carry_backend;
+#elif BINARY_INT_BACKEND == BINARY_INT_BACKEND_KOGGE_STONE
+using default_binary_int_backend = kogge_stone_backend;
+#elif BINARY_INT_BACKEND == BINARY_INT_BACKEND_NATIVE
+using default_binary_int_backend = native_backend;
+#else
+#error "Unknown BINARY_INT_BACKEND"
+#endif
+
+// Bits-wide two's complement integer stored in 64-bit words, least significant word first.
+// The bits of the top word above Bits always hold copies of the sign bit.
+template <std::size_t Bits = 32, typename Backend = default_binary_int_backend>
+class binary_int
+{
+    static_assert(Bits >= 2, "binary_int needs a sign bit and at least one value bit");
+
+public:
+    static constexpr std::size_t word_bits = 64;
+    static constexpr std::size_t word_count = (Bits + word_bits - 1) / word_bits;
+    static constexpr std::size_t karatsuba_threshold = 8;
+
+    using word_type = std::uint64_t;
+    using storage_type = std::array<word_type, word_count>;
+    using value_type = std::conditional_t<(Bits <= 32), int, std::int64_t>;
+
+private:
+    storage_type words_;
+
+    // Widths up to 32 bits run the backend on 32-bit operands: fewer carry steps and loop iterations.
+    using lane_type = std::conditional_t<(Bits <= 32), std::uint32_t, word_type>;
+
+    static constexpr word_type add_carry(word_type a, word_type b, word_type &carry)
+    {
+        word_type sum = Backend::add(Backend::add(a, b), carry);
+        carry = ((a & b) | ((a | b) & ~sum)) >> (word_bits - 1);
+        return sum;
+    }
+
+    // dst[0, dst_length) += src[0, src_length); the carry out of the top word is dropped.
+    static constexpr void add_into(word_type *dst, std::size_t dst_length, const word_type *src, std::size_t src_length)
+    {
+        word_type carry = 0;
+        for (std::size_t i = 0; i < dst_length; ++i)
+        {
+            dst[i] = add_carry(dst[i], i < src_length ? src[i] : 0, carry);
+        }
+    }
+
+    // dst[0, dst_length) -= src[0, src_length), computed as dst + ~src + 1.
+    static constexpr void subtract_from(word_type *dst, std::size_t dst_length, const word_type *src, std::size_t src_length)
+    {
+        word_type carry = 1;
+        for (std::size_t i = 0; i < dst_length; ++i)
+        {
+            dst[i] = add_carry(dst[i], ~(i < src_length ? src[i] : 0), carry);
+        }
+    }
+
+    // Full 64x64 -> 128-bit product from four 32x32 backend multiplies.
+    static constexpr word_type multiply_wide(word_type a, word_type b, word_type &high)
+    {
+        constexpr word_type half_mask = 0xFFFFFFFFu;
+        word_type a0 = a & half_mask;
+        word_type a1 = a >> 32;
+        word_type b0 = b & half_mask;
+        word_type b1 = b >> 32;
+
+        word_type p00 = Backend::multiply(a0, b0);
+        word_type p01 = Backend::multiply(a0, b1);
+        word_type p10 = Backend::multiply(a1, b0);
+        word_type p11 = Backend::multiply(a1, b1);
+
+        word_type middle = Backend::add(Backend::add(p00 >> 32, p01 & half_mask), p10 & half_mask);
+        high = Backend::add(Backend::add(Backend::add(p11, p01 >> 32), p10 >> 32), middle >> 32);
+        return (middle << 32) | (p00 & half_mask);
+    }
+
+    // result[0, result_length) = low words of a * b.
+    static constexpr void multiply_schoolbook(word_type *result, std::size_t result_length,
+                                              const word_type *a, std::size_t a_length,
+                                              const word_type *b, std::size_t b_length)
+    {
+        for (std::size_t i = 0; i < result_length; ++i)
+        {
+            result[i] = 0;
+        }
+        for (std::size_t i = 0; i < a_length && i < result_length; ++i)
+        {
+            word_type carry_word = 0;
+            for (std::size_t j = 0; j < b_length && i + j < result_length; ++j)
+            {
+                word_type high = 0;
+                word_type low = multiply_wide(a[i], b[j], high);
+                word_type carry = 0;
+                word_type sum = add_carry(result[i + j], low, carry);
+                high = Backend::add(high, carry);
+                carry = 0;
+                result[i + j] = add_carry(sum, carry_word, carry);
+                carry_word = Backend::add(high, carry);
+            }
+            if (i + b_length < result_length)
+            {
+                result[i + b_length] = carry_word;
+            }
+        }
+    }
+
+    // Full 2N-word product; splits into halves while N is at or above the threshold.
+    template <std::size_t N>
+    static constexpr std::array<word_type, 2 * N> multiply_karatsuba(const std::array<word_type, N> &a, const std::array<word_type, N> &b)
+    {
+        std::array<word_type, 2 * N> result{};
+        if constexpr (N < karatsuba_threshold)
+        {
+            multiply_schoolbook(result.data(), 2 * N, a.data(), N, b.data(), N);
+        }
+        else
+        {
+            constexpr std::size_t low_length = N / 2;
+            constexpr std::size_t high_length = N - low_length;
+
+            std::array<word_type, low_length> a_low{};
+            std::array<word_type, low_length> b_low{};
+            std::array<word_type, high_length> a_high{};
+            std::array<word_type, high_length> b_high{};
+            std::array<word_type, high_length + 1> a_sum{};
+            std::array<word_type, high_length + 1> b_sum{};
+            for (std::size_t i = 0; i < low_length; ++i)
+            {
+                a_low[i] = a[i];
+                b_low[i] = b[i];
+            }
+            for (std::size_t i = 0; i < high_length; ++i)
+            {
+                a_high[i] = a[low_length + i];
+                b_high[i] = b[low_length + i];
+                a_sum[i] = a_high[i];
+                b_sum[i] = b_high[i];
+            }
+            add_into(a_sum.data(), high_length + 1, a_low.data(), low_length);
+            add_into(b_sum.data(), high_length + 1, b_low.data(), low_length);
+
+            std::array<word_type, 2 * low_length> z0 = multiply_karatsuba<low_length>(a_low, b_low);
+            std::array<word_type, 2 * high_length> z2 = multiply_karatsuba<high_length>(a_high, b_high);
+            std::array<word_type, 2 * high_length + 2> z1 = multiply_karatsuba<high_length + 1>(a_sum, b_sum);
+            subtract_from(z1.data(), z1.size(), z0.data(), z0.size());
+            subtract_from(z1.data(), z1.size(), z2.data(), z2.size());
+
+            add_into(result.data(), 2 * N, z0.data(), z0.size());
+            add_into(result.data() + 2 * low_length, 2 * high_length, z2.data(), z2.size());
+            add_into(result.data() + low_length, 2 * N - low_length, z1.data(), std::min(z1.size(), 2 * N - low_length));
+        }
+        return result;
+    }
+
+    static constexpr storage_type normalize(storage_type words)
+    {
+        constexpr std::size_t unused = word_count * word_bits - Bits;
+        if constexpr (unused > 0)
+        {
+            words[word_count - 1] = static_cast<word_type>(static_cast<std::int64_t>(words[word_count - 1] << unused) >> unused);
+        }
+        return words;
+    }
+
+    static constexpr word_type top_word_mask()
     {
-        return add(~a, 1);
+        constexpr std::size_t used = Bits - (word_count - 1) * word_bits;
+        return used == word_bits ? ~word_type(0) : (word_type(1) << used) - 1;
     }
 
-    static int subtract(int a, int b)
+    // Single-word values are masked to Bits first, so carries never run into the sign extension.
+    static constexpr storage_type add(const storage_type &a, const storage_type &b)
+    {
+        storage_type result = a;
+        if constexpr (word_count == 1)
+        {
+            result[0] = Backend::add(static_cast<lane_type>(a[0] & top_word_mask()), static_cast<lane_type>(b[0] & top_word_mask()));
+        }
+        else
+        {
+            add_into(result.data(), word_count, b.data(), word_count);
+        }
+        return normalize(result);
+    }
+
+    static constexpr storage_type negate(const storage_type &a)
+    {
+        storage_type inverted{};
+        storage_type one{};
+        for (std::size_t i = 0; i < word_count; ++i)
+        {
+            inverted[i] = ~a[i];
+        }
+        one[0] = 1;
+        return add(inverted, one);
+    }
+
+    static constexpr storage_type subtract(const storage_type &a, const storage_type &b)
     {
         return add(a, negate(b));
     }
 
-    static int multiply(int a, int b)
+    // Single words multiply sign and magnitude separately, which keeps the backend loops short for
+    // small negative values. Wider values use the truncated two's complement product, which equals the
+    // sign-magnitude product modulo 2^Bits.
+    static constexpr storage_type multiply(const storage_type &a, const storage_type &b)
     {
-        int result = 0;
-        bool negative = (a < 0) ^ (b < 0);
-        if (a < 0)
-            a = negate(a);
-        if (b < 0)
-            b = negate(b);
+        storage_type result{};
+        if constexpr (word_count == 1)
+        {
+            bool a_negative = static_cast<std::int64_t>(a[0]) < 0;
+            bool b_negative = static_cast<std::int64_t>(b[0]) < 0;
+            constexpr lane_type lane_mask = static_cast<lane_type>(top_word_mask());
+            lane_type a_lane = static_cast<lane_type>(a[0]) & lane_mask;
+            lane_type b_lane = static_cast<lane_type>(b[0]) & lane_mask;
+            lane_type a_magnitude = a_negative ? Backend::add(static_cast<lane_type>(~a_lane), lane_type(1)) & lane_mask : a_lane;
+            lane_type b_magnitude = b_negative ? Backend::add(static_cast<lane_type>(~b_lane), lane_type(1)) & lane_mask : b_lane;
+            lane_type product = Backend::multiply(a_magnitude, b_magnitude);
+            result[0] = a_negative != b_negative ? Backend::add(static_cast<lane_type>(~product), lane_type(1)) : product;
+        }
+        else if constexpr (word_count < karatsuba_threshold)
+        {
+            multiply_schoolbook(result.data(), word_count, a.data(), word_count, b.data(), word_count);
+        }
+        else
+        {
+            std::array<word_type, 2 * word_count> full = multiply_karatsuba<word_count>(a, b);
+            for (std::size_t i = 0; i < word_count; ++i)
+            {
+                result[i] = full[i];
+            }
+        }
+        return normalize(result);
+    }
 
-        while (b)
+    static constexpr storage_type shift_left(const storage_type &a, std::size_t count)
+    {
+        storage_type result{};
+        std::size_t word_shift = count / word_bits;
+        std::size_t bit_shift = count % word_bits;
+        for (std::size_t i = word_count; i-- > word_shift;)
         {
-            if (b & 1)
+            word_type value = a[i - word_shift] << bit_shift;
+            if (bit_shift != 0 && i > word_shift)
             {
-                result = add(result, a);
+                value |= a[i - word_shift - 1] >> (word_bits - bit_shift);
             }
-            a <<= 1;
-            b >>= 1;
+            result[i] = value;
+        }
+        return normalize(result);
+    }
+
+    static constexpr storage_type shift_right(const storage_type &a, std::size_t count)
+    {
+        word_type fill = static_cast<word_type>(static_cast<std::int64_t>(a[word_count - 1]) >> (word_bits - 1));
+        storage_type result{};
+        std::size_t word_shift = count / word_bits;
+        std::size_t bit_shift = count % word_bits;
+        for (std::size_t i = 0; i < word_count; ++i)
+        {
+            std::size_t source = i + word_shift;
+            word_type current = source < word_count ? a[source] : fill;
+            word_type next = source + 1 < word_count ? a[source + 1] : fill;
+            result[i] = bit_shift == 0 ? current : (current >> bit_shift) | (next << (word_bits - bit_shift));
         }
-        return negative ? negate(result) : result;
+        return normalize(result);
+    }
+
+    static constexpr bool get_bit(const storage_type &a, std::size_t position)
+    {
+        return (a[position / word_bits] >> (position % word_bits)) & 1;
     }
 
+    static constexpr void check_shift(const binary_int &amount)
+    {
+        if (amount.is_negative() || amount.words_[0] >= Bits - 1 || !amount.fits_in_low_word())
+        {
+            throw std::out_of_range("Shift amount is out of range");
+        }
+    }
+
+    constexpr bool is_negative() const
+    {
+        return static_cast<std::int64_t>(words_[word_count - 1]) < 0;
+    }
+
+    constexpr bool fits_in_low_word() const
+    {
+        for (std::size_t i = 1; i < word_count; ++i)
+        {
+            if (words_[i] != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    explicit constexpr binary_int(const storage_type &words) : words_(normalize(words)) {}
+
 public:
-    binary_int(int value = 0) : value_(value) {}
+    constexpr binary_int(long long value = 0) : words_{}
+    {
+        for (std::size_t i = 0; i < word_count; ++i)
+        {
+            words_[i] = static_cast<word_type>(value < 0 ? -1 : 0);
+        }
+        words_[0] = static_cast<word_type>(value);
+        words_ = normalize(words_);
+    }
 
-    binary_int(const binary_int &other) : value_(other.value_) {}
+    constexpr binary_int(const binary_int &other) : words_(other.words_) {}
 
-    binary_int &operator=(const binary_int &other)
+    constexpr binary_int &operator=(const binary_int &other)
     {
         if (this != &other)
         {
-            value_ = other.value_;
+            words_ = other.words_;
         }
         return *this;
     }
 
     ~binary_int() = default;
 
-    int get_value() const { return value_; }
+    constexpr value_type get_value() const { return static_cast<value_type>(words_[0]); }
+
+    constexpr word_type get_word(std::size_t index) const
+    {
+        if (index >= word_count)
+        {
+            throw std::out_of_range("Word index is out of range");
+        }
+        return words_[index];
+    }
 
-    binary_int operator-() const
+    constexpr binary_int operator-() const
     {
-        return binary_int(negate(value_));
+        return binary_int(negate(words_));
     }
 
-    binary_int &operator++()
+    constexpr binary_int &operator++()
     {
-        value_ = add(value_, 1);
+        words_ = add(words_, binary_int(1).words_);
         return *this;
     }
 
-    binary_int operator++(int)
+    constexpr binary_int operator++(int)
     {
         binary_int temp(*this);
         ++(*this);
         return temp;
     }
 
-    binary_int &operator--()
+    constexpr binary_int &operator--()
     {
-        value_ = subtract(value_, 1);
+        words_ = subtract(words_, binary_int(1).words_);
         return *this;
     }
 
-    binary_int operator--(int)
+    constexpr binary_int operator--(int)
     {
         binary_int temp(*this);
         --(*this);
         return temp;
     }
 
-    binary_int &operator+=(const binary_int &other)
+    constexpr binary_int &operator+=(const binary_int &other)
+    {
+        words_ = add(words_, other.words_);
+        return *this;
+    }
+
+    constexpr binary_int operator+(const binary_int &other) const
+    {
+        return binary_int(add(words_, other.words_));
+    }
+
+    constexpr binary_int &operator-=(const binary_int &other)
+    {
+        words_ = subtract(words_, other.words_);
+        return *this;
+    }
+
+    constexpr binary_int operator-(const binary_int &other) const
+    {
+        return binary_int(subtract(words_, other.words_));
+    }
+
+    constexpr binary_int &operator*=(const binary_int &other)
     {
-        value_ = add(value_, other.value_);
+        words_ = multiply(words_, other.words_);
         return *this;
     }
 
-    binary_int operator+(const binary_int &other) const
+    constexpr binary_int operator*(const binary_int &other) const
     {
-        return binary_int(add(value_, other.value_));
+        return binary_int(multiply(words_, other.words_));
     }
 
-    binary_int &operator-=(const binary_int &other)
+    constexpr binary_int &operator<<=(const binary_int &other)
     {
-        value_ = subtract(value_, other.value_);
+        check_shift(other);
+        words_ = shift_left(words_, static_cast<std::size_t>(other.words_[0]));
         return *this;
     }
 
-    binary_int operator-(const binary_int &other) const
+    constexpr binary_int operator<<(const binary_int &other) const
     {
-        return binary_int(subtract(value_, other.value_));
+        check_shift(other);
+        return binary_int(shift_left(words_, static_cast<std::size_t>(other.words_[0])));
     }
 
-    binary_int &operator*=(const binary_int &other)
+    constexpr binary_int &operator>>=(const binary_int &other)
     {
-        value_ = multiply(value_, other.value_);
+        check_shift(other);
+        words_ = shift_right(words_, static_cast<std::size_t>(other.words_[0]));
         return *this;
     }
 
-    binary_int operator*(const binary_int &other) const
+    constexpr binary_int operator>>(const binary_int &other) const
     {
-        return binary_int(multiply(value_, other.value_));
+        check_shift(other);
+        return binary_int(shift_right(words_, static_cast<std::size_t>(other.words_[0])));
     }
 
-    binary_int &operator<<=(const binary_int &other)
+    constexpr std::pair<binary_int, binary_int> split_bits() const
     {
-        if (other.value_ < 0 || other.value_ >= std::numeric_limits<int>::digits)
+        std::size_t half_bit_count = (Bits - 1) / 2;
+        storage_type mask_lower{};
+        storage_type mask_upper{};
+        for (std::size_t i = 0; i < half_bit_count; ++i)
         {
-            throw std::out_of_range("Shift amount is out of range");
+            mask_lower[i / word_bits] |= word_type(1) << (i % word_bits);
+            mask_upper[(i + half_bit_count) / word_bits] |= word_type(1) << ((i + half_bit_count) % word_bits);
         }
-        value_ <<= other.value_;
-        return *this;
+
+        storage_type upper{};
+        storage_type lower{};
+        for (std::size_t i = 0; i < word_count; ++i)
+        {
+            upper[i] = words_[i] & mask_upper[i];
+            lower[i] = words_[i] & mask_lower[i];
+        }
+        return std::make_pair(binary_int(upper), binary_int(lower));
     }
 
-    binary_int operator<<(const binary_int &other) const
+    friend std::ostream &operator<<(std::ostream &os, const binary_int &obj)
     {
-        if (other.value_ < 0 || other.value_ >= std::numeric_limits<int>::digits)
+        for (std::size_t i = Bits - 1; i-- > 0;)
         {
-            throw std::out_of_range("Shift amount is out of range");
+            os << get_bit(obj.words_, i);
         }
-        return binary_int(value_ << other.value_);
+        return os;
+    }
+};
+
+// Table of i * i for i in [0, N), filled entirely during constant evaluation.
+template <std::size_t N, std::size_t Bits = 32, typename Backend = default_binary_int_backend>
+constexpr std::array<binary_int<Bits, Backend>, N> make_square_table()
+{
+    std::array<binary_int<Bits, Backend>, N> table{};
+    binary_int<Bits, Backend> i(0);
+    for (std::size_t n = 0; n < N; ++n, ++i)
+    {
+        table[n] = i * i;
     }
+    return table;
+}
+
+namespace binary_int_constexpr_tests
+{
+    constexpr binary_int<> a(10);
+    constexpr binary_int<> b(5);
+
+    static_assert((a + b).get_value() == 15);
+    static_assert((a - b).get_value() == 5);
+    static_assert((b - a).get_value() == -5);
+    static_assert((a * b).get_value() == 50);
+    static_assert((a * -b).get_value() == -50);
+    static_assert((-a).get_value() == -10);
+    static_assert((a << binary_int<>(2)).get_value() == 40);
+    static_assert((binary_int<>(-16) >> binary_int<>(2)).get_value() == -4);
+    static_assert((binary_int<>(std::numeric_limits<int>::max()) + binary_int<>(1)).get_value() == std::numeric_limits<int>::min());
+    static_assert(a.split_bits().second.get_value() == 10);
 
-    binary_int &operator>>=(const binary_int &other)
+    constexpr binary_int<> apply_compound_operators(binary_int<> value)
     {
-        if (other.value_ < 0 || other.value_ >= std::numeric_limits<int>::digits)
+        value++;
+        ++value;
+        value -= binary_int<>(1);
+        value *= binary_int<>(3);
+        value <<= binary_int<>(1);
+        value >>= binary_int<>(1);
+        return value;
+    }
+    static_assert(apply_compound_operators(a).get_value() == 33);
+
+    static_assert((binary_int<32, ripple_carry_backend>(-7) * binary_int<32, ripple_carry_backend>(6)).get_value() == -42);
+    static_assert((binary_int<32, kogge_stone_backend>(-7) * binary_int<32, kogge_stone_backend>(6)).get_value() == -42);
+    static_assert((binary_int<16, kogge_stone_backend>(32767) + binary_int<16, kogge_stone_backend>(1)).get_value() == -32768);
+
+    constexpr binary_int<128> wide = binary_int<128>(std::numeric_limits<long long>::max()) + binary_int<128>(1);
+    static_assert(wide.get_word(0) == std::uint64_t(1) << 63 && wide.get_word(1) == 0);
+    static_assert((wide * wide).get_word(1) == std::uint64_t(1) << 62);
+
+    constexpr binary_int<1024> power = binary_int<1024>(1) << binary_int<1024>(400);
+    static_assert((power * power).get_word(12) == std::uint64_t(1) << 32);
+    static_assert((-power * power).get_word(15) == ~std::uint64_t(0));
+
+    constexpr auto squares = make_square_table<64>();
+    static_assert(squares[0].get_value() == 0 && squares[7].get_value() == 49 && squares[63].get_value() == 3969);
+}
+
+// Lane types for the bulk kernels: the same bitwise algorithms run on one 32-bit value at a time
+// (scalar tails) or on a whole SIMD register of packed int32 values.
+struct scalar_int32_lanes
+{
+    using vector = std::uint32_t;
+    static constexpr std::size_t width = 1;
+
+    static vector load(const int *source) { return static_cast<vector>(*source); }
+    static void store(int *destination, vector value) { *destination = static_cast<int>(value); }
+    static vector broadcast(int value) { return static_cast<vector>(value); }
+    static vector bit_and(vector a, vector b) { return a & b; }
+    static vector bit_or(vector a, vector b) { return a | b; }
+    static vector bit_xor(vector a, vector b) { return a ^ b; }
+    static vector bit_not(vector a) { return ~a; }
+    static vector shift_left(vector a, int count) { return a << count; }
+    static vector shift_right(vector a, int count) { return static_cast<vector>(static_cast<int>(a) >> count); }
+    static vector native_add(vector a, vector b) { return a + b; }
+    static vector native_multiply(vector a, vector b) { return a * b; }
+};
+
+#if defined(__AVX2__)
+struct simd_int32_lanes
+{
+    using vector = __m256i;
+    static constexpr std::size_t width = 8;
+
+    static vector load(const int *source) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source)); }
+    static void store(int *destination, vector value) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination), value); }
+    static vector broadcast(int value) { return _mm256_set1_epi32(value); }
+    static vector bit_and(vector a, vector b) { return _mm256_and_si256(a, b); }
+    static vector bit_or(vector a, vector b) { return _mm256_or_si256(a, b); }
+    static vector bit_xor(vector a, vector b) { return _mm256_xor_si256(a, b); }
+    static vector bit_not(vector a) { return _mm256_xor_si256(a, _mm256_set1_epi32(-1)); }
+    static vector shift_left(vector a, int count) { return _mm256_sll_epi32(a, _mm_cvtsi32_si128(count)); }
+    static vector shift_right(vector a, int count) { return _mm256_sra_epi32(a, _mm_cvtsi32_si128(count)); }
+    static vector native_add(vector a, vector b) { return _mm256_add_epi32(a, b); }
+    static vector native_multiply(vector a, vector b) { return _mm256_mullo_epi32(a, b); }
+};
+#elif defined(__SSE2__)
+struct simd_int32_lanes
+{
+    using vector = __m128i;
+    static constexpr std::size_t width = 4;
+
+    static vector load(const int *source) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(source)); }
+    static void store(int *destination, vector value) { _mm_storeu_si128(reinterpret_cast<__m128i *>(destination), value); }
+    static vector broadcast(int value) { return _mm_set1_epi32(value); }
+    static vector bit_and(vector a, vector b) { return _mm_and_si128(a, b); }
+    static vector bit_or(vector a, vector b) { return _mm_or_si128(a, b); }
+    static vector bit_xor(vector a, vector b) { return _mm_xor_si128(a, b); }
+    static vector bit_not(vector a) { return _mm_xor_si128(a, _mm_set1_epi32(-1)); }
+    static vector shift_left(vector a, int count) { return _mm_sll_epi32(a, _mm_cvtsi32_si128(count)); }
+    static vector shift_right(vector a, int count) { return _mm_sra_epi32(a, _mm_cvtsi32_si128(count)); }
+    static vector native_add(vector a, vector b) { return _mm_add_epi32(a, b); }
+#if defined(__SSE4_1__)
+    static vector native_multiply(vector a, vector b) { return _mm_mullo_epi32(a, b); }
+#else
+    // SSE2 only multiplies even lanes into 64-bit products; odd lanes are shifted down and the low halves merged.
+    static vector native_multiply(vector a, vector b)
+    {
+        __m128i even = _mm_mul_epu32(a, b);
+        __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+        return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+    }
+#endif
+};
+#else
+using simd_int32_lanes = scalar_int32_lanes;
+#endif
+
+// Span-based operations over packed int32 values with binary_int<32, Backend> semantics.
+// Bitwise backends run a Kogge-Stone adder and a carry-save multiplier in every lane at once:
+// both have a fixed number of steps, so no lane waits for another lane's carries to clear.
+// The native backend maps onto the hardware vector add and multiply.
+template <typename Backend = default_binary_int_backend>
+class binary_int_bulk
+{
+private:
+    static constexpr bool native = std::is_same_v<Backend, native_backend>;
+
+    template <typename Lanes>
+    static typename Lanes::vector add_lanes(typename Lanes::vector a, typename Lanes::vector b)
+    {
+        if constexpr (native)
         {
-            throw std::out_of_range("Shift amount is out of range");
+            return Lanes::native_add(a, b);
         }
-        value_ >>= other.value_;
-        return *this;
+        else
+        {
+            typename Lanes::vector generate = Lanes::bit_and(a, b);
+            typename Lanes::vector propagate = Lanes::bit_xor(a, b);
+            for (int shift = 1; shift < 32; shift <<= 1)
+            {
+                generate = Lanes::bit_or(generate, Lanes::bit_and(propagate, Lanes::shift_left(generate, shift)));
+                propagate = Lanes::bit_and(propagate, Lanes::shift_left(propagate, shift));
+            }
+            return Lanes::bit_xor(Lanes::bit_xor(a, b), Lanes::shift_left(generate, 1));
+        }
+    }
+
+    template <typename Lanes>
+    static typename Lanes::vector negate_lanes(typename Lanes::vector a)
+    {
+        return add_lanes<Lanes>(Lanes::bit_not(a), Lanes::broadcast(1));
+    }
+
+    template <typename Lanes>
+    static typename Lanes::vector subtract_lanes(typename Lanes::vector a, typename Lanes::vector b)
+    {
+        return add_lanes<Lanes>(a, negate_lanes<Lanes>(b));
     }
 
-    binary_int operator>>(const binary_int &other) const
+    template <typename Lanes>
+    static typename Lanes::vector multiply_lanes(typename Lanes::vector a, typename Lanes::vector b)
     {
-        if (other.value_ < 0 || other.value_ >= std::numeric_limits<int>::digits)
+        if constexpr (native)
         {
-            throw std::out_of_range("Shift amount is out of range");
+            return Lanes::native_multiply(a, b);
+        }
+        else
+        {
+            typename Lanes::vector sum = Lanes::broadcast(0);
+            typename Lanes::vector carry = Lanes::broadcast(0);
+            for (int bit = 0; bit < 32; ++bit)
+            {
+                typename Lanes::vector mask = Lanes::shift_right(Lanes::shift_left(b, 31 - bit), 31);
+                typename Lanes::vector partial = Lanes::bit_and(a, mask);
+                typename Lanes::vector next_sum = Lanes::bit_xor(Lanes::bit_xor(sum, carry), partial);
+                carry = Lanes::shift_left(Lanes::bit_or(Lanes::bit_or(Lanes::bit_and(sum, carry), Lanes::bit_and(sum, partial)),
+                                                        Lanes::bit_and(carry, partial)),
+                                          1);
+                sum = next_sum;
+                a = Lanes::shift_left(a, 1);
+            }
+            return add_lanes<Lanes>(sum, carry);
         }
-        return binary_int(value_ >> other.value_);
     }
 
-    std::pair<binary_int, binary_int> split_bits() const
+    template <typename Operation>
+    static void for_each_lane(std::span<const int> a, std::span<const int> b, std::span<int> out, Operation operation)
     {
-        int half_bit_count = std::numeric_limits<int>::digits / 2;
-        int mask_lower = (1 << half_bit_count) - 1;
-        int mask_upper = mask_lower << half_bit_count;
+        if (a.size() != out.size() || b.size() != out.size())
+        {
+            throw std::invalid_argument("Bulk operands and result must have the same length");
+        }
 
-        return std::make_pair(binary_int(value_ & mask_upper),
-                              binary_int(value_ & mask_lower));
+        std::size_t i = 0;
+        for (; i + simd_int32_lanes::width <= out.size(); i += simd_int32_lanes::width)
+        {
+            simd_int32_lanes::store(&out[i], operation(simd_int32_lanes(), simd_int32_lanes::load(&a[i]), simd_int32_lanes::load(&b[i])));
+        }
+        for (; i < out.size(); ++i)
+        {
+            scalar_int32_lanes::store(&out[i], operation(scalar_int32_lanes(), scalar_int32_lanes::load(&a[i]), scalar_int32_lanes::load(&b[i])));
+        }
     }
 
-    friend std::ostream &operator<<(std::ostream &os, const binary_int &obj)
+    static void check_shift(int count)
     {
-        for (int i = std::numeric_limits<int>::digits - 1; i >= 0; --i)
+        if (count < 0 || count >= std::numeric_limits<int>::digits)
         {
-            os << ((obj.value_ >> i) & 1);
+            throw std::out_of_range("Shift amount is out of range");
         }
-        return os;
+    }
+
+public:
+    static void add(std::span<const int> a, std::span<const int> b, std::span<int> out)
+    {
+        for_each_lane(a, b, out, [](auto lanes, auto x, auto y)
+                      { return add_lanes<decltype(lanes)>(x, y); });
+    }
+
+    static void subtract(std::span<const int> a, std::span<const int> b, std::span<int> out)
+    {
+        for_each_lane(a, b, out, [](auto lanes, auto x, auto y)
+                      { return subtract_lanes<decltype(lanes)>(x, y); });
+    }
+
+    static void multiply(std::span<const int> a, std::span<const int> b, std::span<int> out)
+    {
+        for_each_lane(a, b, out, [](auto lanes, auto x, auto y)
+                      { return multiply_lanes<decltype(lanes)>(x, y); });
+    }
+
+    static void negate(std::span<const int> a, std::span<int> out)
+    {
+        for_each_lane(a, a, out, [](auto lanes, auto x, auto)
+                      { return negate_lanes<decltype(lanes)>(x); });
+    }
+
+    static void shift_left(std::span<const int> a, int count, std::span<int> out)
+    {
+        check_shift(count);
+        for_each_lane(a, a, out, [count](auto lanes, auto x, auto)
+                      { return decltype(lanes)::shift_left(x, count); });
+    }
+
+    static void shift_right(std::span<const int> a, int count, std::span<int> out)
+    {
+        check_shift(count);
+        for_each_lane(a, a, out, [count](auto lanes, auto x, auto)
+                      { return decltype(lanes)::shift_right(x, count); });
     }
 };
 
-int main()
+template <typename Backend>
+int benchmark_backend(const char *name, const std::vector<int> &operands)
+{
+    const int iterations = 1 << 20;
+    const size_t mask = operands.size() - 1;
+    double ns_per_op[3];
+
+    for (int op = 0; op < 3; ++op)
+    {
+        binary_int<32, Backend> acc(1);
+        auto start = std::chrono::steady_clock::now();
+        for (int n = 0; n < iterations; ++n)
+        {
+            binary_int<32, Backend> operand(operands[n & mask]);
+            if (op == 0)
+            {
+                acc += operand;
+            }
+            else if (op == 1)
+            {
+                acc = acc * operand;
+            }
+            else
+            {
+                acc = (acc << binary_int<32, Backend>(operands[n & mask] & 15)) >> binary_int<32, Backend>(3);
+            }
+        }
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        volatile int sink = acc.get_value();
+        (void)sink;
+        ns_per_op[op] = elapsed.count() / iterations;
+    }
+
+    std::cout << std::left << std::setw(14) << name << std::fixed << std::setprecision(2)
+              << std::setw(10) << ns_per_op[0] << std::setw(12) << ns_per_op[1] << ns_per_op[2] << std::endl;
+    return 0;
+}
+
+template <typename Backend>
+int benchmark_bulk(const char *name, const std::vector<int> &a, const std::vector<int> &b)
 {
+    std::vector<int> scalar_result(a.size());
+    std::vector<int> bulk_result(a.size());
+    double ns_per_element[4];
+
+    for (int op = 0; op < 2; ++op)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            binary_int<32, Backend> x(a[i]);
+            binary_int<32, Backend> y(b[i]);
+            scalar_result[i] = (op == 0 ? x + y : x * y).get_value();
+        }
+        std::chrono::duration<double, std::nano> scalar_time = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        if (op == 0)
+        {
+            binary_int_bulk<Backend>::add(a, b, bulk_result);
+        }
+        else
+        {
+            binary_int_bulk<Backend>::multiply(a, b, bulk_result);
+        }
+        std::chrono::duration<double, std::nano> bulk_time = std::chrono::steady_clock::now() - start;
+
+        if (scalar_result != bulk_result)
+        {
+            std::cerr << "Error: bulk and scalar results differ for " << name << std::endl;
+            return 1;
+        }
+        ns_per_element[2 * op] = scalar_time.count() / a.size();
+        ns_per_element[2 * op + 1] = bulk_time.count() / a.size();
+    }
+
+    std::cout << std::left << std::setw(14) << name << std::fixed << std::setprecision(2)
+              << std::setw(13) << ns_per_element[0] << std::setw(11) << ns_per_element[1]
+              << std::setw(13) << ns_per_element[2] << ns_per_element[3] << std::endl;
+    return 0;
+}
+
+int run_benchmark()
+{
+    std::vector<int> operands(1024);
+    unsigned int seed = 12345;
+    for (int &operand : operands)
+    {
+        seed = seed * 1103515245u + 12345u;
+        operand = static_cast<int>(seed);
+    }
+
+    std::cout << "ns/op         add       multiply    shift" << std::endl;
+    if (benchmark_backend<ripple_carry_backend>("ripple", operands) != 0 ||
+        benchmark_backend<kogge_stone_backend>("kogge-stone", operands) != 0 ||
+        benchmark_backend<native_backend>("native", operands) != 0)
+    {
+        return 1;
+    }
+
+    std::vector<int> a(1 << 20);
+    std::vector<int> b(a.size());
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        a[i] = static_cast<int>(seed);
+        seed = seed * 1103515245u + 12345u;
+        b[i] = static_cast<int>(seed);
+    }
+
+    std::cout << std::endl
+              << "ns/element    scalar add   bulk add   scalar mul   bulk mul" << std::endl;
+    if (benchmark_bulk<ripple_carry_backend>("ripple", a, b) != 0 ||
+        benchmark_bulk<kogge_stone_backend>("kogge-stone", a, b) != 0 ||
+        benchmark_bulk<native_backend>("native", a, b) != 0)
+    {
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 2 || (argc == 2 && std::strcmp(argv[1], "--bench") != 0))
+    {
+        std::cerr << "Usage: " << argv[0] << " [--bench]" << std::endl;
+        return 1;
+    }
+    if (argc == 2)
+    {
+        return run_benchmark();
+    }
+
     try
     {
         binary_int a(10);
@@ -242,6 +1013,20 @@ int main()
         std::cout << "a split low: " << splitted.second << " (" << splitted.second.get_value()
                   << ")" << std::endl;
 
+        constexpr auto squares = make_square_table<8>();
+        std::cout << "Compile-time squares:";
+        for (const auto &square : squares)
+        {
+            std::cout << " " << square.get_value();
+        }
+        std::cout << std::endl;
+
+        binary_int<128> wide(std::numeric_limits<long long>::max());
+        ++wide;
+        std::cout << "128-bit INT64_MAX + 1: high word " << wide.get_word(1) << ", low word " << wide.get_word(0) << std::endl;
+        wide *= wide;
+        std::cout << "squared: high word " << wide.get_word(1) << ", low word " << wide.get_word(0) << std::endl;
+
         binary_int big_val(std::numeric_limits<int>::max());
         binary_int shift_big_val(33);
         try
@@ -5,9 +5,27 @@
 #include <string>
 #include <cstring>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
 #include <limits.h>
 #include <algorithm>
 #include <stdexcept>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <future>
+#include <system_error>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 using namespace std;
 
@@ -21,6 +39,7 @@ enum ret_type_t
     ERROR_FILE_OPERATION,
     ERROR_MEMORY_ALLOCATION,
     ERROR_INVALID_ARGUMENT,
+    ERROR_INDEX_MISMATCH,
 };
 
 void logErrors(int code)
@@ -50,35 +69,435 @@ void logErrors(int code)
     case ERROR_INVALID_ARGUMENT:
         cerr << "Error: Invalid argument passed to function." << endl;
         break;
+    case ERROR_INDEX_MISMATCH:
+        cerr << "Error: Checkpoint index does not match the key or the file." << endl;
+        break;
     default:
         cerr << "Error: An unknown error occurred (code: " << code << ")." << endl;
         break;
     }
 }
 
+struct EncodeJob
+{
+    string inputFilePath;
+    string outputFilePath;
+    bool encrypt;
+};
+
+struct BatchReport
+{
+    vector<int> codes;
+    size_t bytesProcessed;
+    double seconds;
+};
+
 class Encoder
 {
 public:
+    enum class EncodeMode
+    {
+        STREAM,
+        MAPPED,
+    };
+
     Encoder(const vector<byte> &_key) : key(_key)
     {
         if (key.empty())
         {
             throw invalid_argument("Encryption key cannot be empty.");
         }
+        initState(keyState);
     }
 
-    Encoder(const Encoder &other) : key(other.key) {}
+    Encoder(const Encoder &other)
+        : key(other.key), mode(other.mode), keyState(other.keyState), prefix(other.prefix), prefixState(other.prefixState) {}
     Encoder &operator=(const Encoder &other)
     {
         if (this != &other)
         {
             key = other.key;
+            mode = other.mode;
+            keyState = other.keyState;
+            prefix = other.prefix;
+            prefixState = other.prefixState;
         }
         return *this;
     }
     ~Encoder() = default;
 
     int encode(const string &inputFilePath, const string &outputFilePath, bool encrypt) const
+    {
+        return encodeFile(inputFilePath, outputFilePath, workerCount());
+    }
+
+    // Encrypts or decrypts an in-memory buffer in place, starting from the beginning of the keystream.
+    int encodeBuffer(uint8_t *data, size_t length) const
+    {
+        if (data == nullptr && length > 0)
+        {
+            return ERROR_INVALID_ARGUMENT;
+        }
+
+        KeystreamCursor cursor = {keyState, 0};
+        alignas(64) uint8_t keystream[4096];
+        for (size_t done = 0; done < length; done += sizeof(keystream))
+        {
+            size_t count = min(sizeof(keystream), length - done);
+            fillKeystream(cursor, keystream, count);
+            xorBlock(data + done, keystream, count);
+        }
+        return SUCCESS;
+    }
+
+    // Runs the jobs on a work-stealing pool sized to the cores; each job is encoded on a single thread.
+    // report.codes[n] holds the result of jobs[n]; the return value is the first failing code, if any.
+    int encodeBatch(const vector<EncodeJob> &jobs, BatchReport &report) const
+    {
+        report.bytesProcessed = 0;
+        report.seconds = 0.0;
+        try
+        {
+            report.codes.assign(jobs.size(), SUCCESS);
+        }
+        catch (const bad_alloc &e)
+        {
+            return ERROR_MEMORY_ALLOCATION;
+        }
+        if (jobs.empty())
+        {
+            return SUCCESS;
+        }
+
+        unsigned cores = thread::hardware_concurrency();
+        size_t workers = min<size_t>(jobs.size(), cores ? cores : 1);
+        unique_ptr<WorkQueue[]> queues;
+        vector<size_t> bytes;
+        try
+        {
+            queues.reset(new WorkQueue[workers]);
+            bytes.assign(workers, 0);
+            for (size_t n = 0; n < jobs.size(); ++n)
+            {
+                queues[n * workers / jobs.size()].jobs.push_back(n);
+            }
+        }
+        catch (const bad_alloc &e)
+        {
+            return ERROR_MEMORY_ALLOCATION;
+        }
+
+        auto start = chrono::steady_clock::now();
+        vector<thread> threads;
+        try
+        {
+            threads.reserve(workers - 1);
+            for (size_t w = 1; w < workers; ++w)
+            {
+                threads.emplace_back(&Encoder::runBatchWorker, this, cref(jobs), queues.get(), workers, w, ref(report.codes), ref(bytes[w]));
+            }
+        }
+        catch (const exception &e)
+        {
+            // Jobs queued for workers that failed to start are stolen by the running ones.
+        }
+        runBatchWorker(jobs, queues.get(), workers, 0, report.codes, bytes[0]);
+        for (thread &t : threads)
+        {
+            t.join();
+        }
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+        report.seconds = elapsed.count();
+        for (size_t b : bytes)
+        {
+            report.bytesProcessed += b;
+        }
+        for (int code : report.codes)
+        {
+            if (code != SUCCESS)
+            {
+                return code;
+            }
+        }
+        return SUCCESS;
+    }
+
+    // Writes the RC4 state every intervalBytes of keystream up to the size of the encrypted file.
+    // The index holds raw cipher states and must be protected like the key itself.
+    int buildCheckpointIndex(const string &encryptedFilePath, const string &indexPath, size_t intervalBytes = 16 << 20) const
+    {
+        if (encryptedFilePath.empty() || indexPath.empty())
+        {
+            return ERROR_INVALID_FILE_PATH;
+        }
+        if (intervalBytes == 0)
+        {
+            return ERROR_INVALID_ARGUMENT;
+        }
+
+        struct stat fileStat;
+        if (stat(encryptedFilePath.c_str(), &fileStat) != 0)
+        {
+            return ERROR_OPEN_FILE;
+        }
+        uint64_t fileSize = static_cast<uint64_t>(fileStat.st_size);
+        uint64_t count = fileSize / intervalBytes + 1;
+
+        unique_ptr<uint8_t[]> scratch;
+        try
+        {
+            scratch.reset(new uint8_t[BLOCK_SIZE]);
+        }
+        catch (const bad_alloc &e)
+        {
+            return ERROR_MEMORY_ALLOCATION;
+        }
+
+        ofstream index(indexPath, ios::binary);
+        if (!index.is_open())
+        {
+            return ERROR_OPEN_FILE;
+        }
+
+        CheckpointHeader header = {};
+        memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+        header.interval = intervalBytes;
+        header.count = count;
+        index.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+        Rc4State state = keyState;
+        for (uint64_t n = 0; n < count && index; ++n)
+        {
+            if (n > 0)
+            {
+                skipKeystream(state, intervalBytes, scratch.get(), BLOCK_SIZE);
+            }
+            index.write(reinterpret_cast<const char *>(&state), sizeof(state));
+        }
+
+        int code = index ? SUCCESS : ERROR_FILE_OPERATION;
+        index.close();
+        return code;
+    }
+
+    // Decrypts [offset, offset + length) of a file encrypted with this key, starting from the
+    // nearest checkpoint in the index instead of the beginning of the keystream.
+    int decryptRange(const string &encryptedFilePath, const string &indexPath, uint64_t offset, size_t length, vector<byte> &out) const
+    {
+        if (encryptedFilePath.empty() || indexPath.empty())
+        {
+            return ERROR_INVALID_FILE_PATH;
+        }
+
+        ifstream index(indexPath, ios::binary);
+        if (!index.is_open())
+        {
+            return ERROR_OPEN_FILE;
+        }
+        CheckpointHeader header;
+        Rc4State first;
+        if (!index.read(reinterpret_cast<char *>(&header), sizeof(header)) || !index.read(reinterpret_cast<char *>(&first), sizeof(first)))
+        {
+            return ERROR_INDEX_MISMATCH;
+        }
+        if (memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) != 0 || header.interval == 0 || header.count == 0 ||
+            memcmp(&first, &keyState, sizeof(first)) != 0)
+        {
+            return ERROR_INDEX_MISMATCH;
+        }
+
+        ifstream inputFile(encryptedFilePath, ios::binary);
+        if (!inputFile.is_open())
+        {
+            return ERROR_OPEN_FILE;
+        }
+        inputFile.seekg(0, ios::end);
+        uint64_t fileSize = static_cast<uint64_t>(inputFile.tellg());
+        if (offset > fileSize || length > fileSize - offset)
+        {
+            return ERROR_INVALID_ARGUMENT;
+        }
+        if (fileSize / header.interval >= header.count)
+        {
+            return ERROR_INDEX_MISMATCH;
+        }
+
+        uint64_t checkpoint = offset / header.interval;
+        Rc4State state = first;
+        if (checkpoint > 0)
+        {
+            index.seekg(static_cast<streamoff>(sizeof(header) + checkpoint * sizeof(Rc4State)));
+            if (!index.read(reinterpret_cast<char *>(&state), sizeof(state)))
+            {
+                return ERROR_INDEX_MISMATCH;
+            }
+        }
+
+        try
+        {
+            out.resize(length);
+            uint64_t skip = offset - checkpoint * header.interval;
+            size_t keystreamSize = static_cast<size_t>(min<uint64_t>(BLOCK_SIZE, max<uint64_t>(max<uint64_t>(length, skip), 1)));
+            unique_ptr<uint8_t[]> keystream(new uint8_t[keystreamSize]);
+            skipKeystream(state, skip, keystream.get(), keystreamSize);
+
+            inputFile.seekg(static_cast<streamoff>(offset));
+            if (!inputFile.read(reinterpret_cast<char *>(out.data()), static_cast<streamsize>(length)))
+            {
+                return ERROR_FILE_OPERATION;
+            }
+            uint8_t *data = reinterpret_cast<uint8_t *>(out.data());
+            for (size_t done = 0; done < length; done += keystreamSize)
+            {
+                size_t count = min(keystreamSize, length - done);
+                generateKeystream(state, keystream.get(), count);
+                xorBlock(data + done, keystream.get(), count);
+            }
+        }
+        catch (const bad_alloc &e)
+        {
+            return ERROR_MEMORY_ALLOCATION;
+        }
+
+        return SUCCESS;
+    }
+
+    int setKey(const vector<byte> &newKey)
+    {
+        if (newKey.empty())
+        {
+            return ERROR_INVALID_ARGUMENT;
+        }
+        key = newKey;
+        initState(keyState);
+        return setKeystreamCacheSize(prefix.size());
+    }
+
+    // Keeps the first `bytes` of keystream for the current key, so short files skip RC4 entirely.
+    int setKeystreamCacheSize(size_t bytes)
+    {
+        try
+        {
+            prefix.resize(bytes);
+        }
+        catch (const bad_alloc &e)
+        {
+            prefix.clear();
+            return ERROR_MEMORY_ALLOCATION;
+        }
+        prefixState = keyState;
+        generateKeystream(prefixState, prefix.data(), prefix.size());
+        return SUCCESS;
+    }
+
+    // MAPPED (the default) falls back to STREAM for pipes, devices and empty files.
+    void setMode(EncodeMode newMode)
+    {
+        mode = newMode;
+    }
+
+private:
+    static constexpr size_t BLOCK_SIZE = 4 << 20;
+    static constexpr size_t MIN_PARALLEL_XOR = 256 << 10;
+    static constexpr size_t KEYSTREAM_BLOCK = 64;
+
+    struct Rc4State
+    {
+        uint8_t S[256];
+        uint8_t i;
+        uint8_t j;
+    };
+
+    static constexpr char CHECKPOINT_MAGIC[8] = {'R', 'C', '4', 'C', 'K', 'P', 'T', '1'};
+
+    struct CheckpointHeader
+    {
+        char magic[8];
+        uint64_t interval;
+        uint64_t count;
+    };
+
+    struct KeystreamCursor
+    {
+        Rc4State state;
+        size_t position;
+    };
+
+    struct FileMapping
+    {
+        int fd = -1;
+        void *addr = MAP_FAILED;
+        size_t size = 0;
+
+        FileMapping() = default;
+        FileMapping(const FileMapping &) = delete;
+        FileMapping &operator=(const FileMapping &) = delete;
+        ~FileMapping()
+        {
+            if (addr != MAP_FAILED)
+            {
+                munmap(addr, size);
+            }
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+        }
+    };
+
+    vector<byte> key;
+    EncodeMode mode = EncodeMode::MAPPED;
+    Rc4State keyState;
+    vector<uint8_t> prefix;
+    Rc4State prefixState;
+
+    struct WorkQueue
+    {
+        mutex lock;
+        deque<size_t> jobs;
+    };
+
+    // Owners take jobs from the front of their own queue, thieves from the back of the others.
+    static bool takeJob(WorkQueue *queues, size_t workers, size_t self, size_t &job)
+    {
+        for (size_t n = 0; n < workers; ++n)
+        {
+            WorkQueue &queue = queues[(self + n) % workers];
+            lock_guard<mutex> guard(queue.lock);
+            if (!queue.jobs.empty())
+            {
+                if (n == 0)
+                {
+                    job = queue.jobs.front();
+                    queue.jobs.pop_front();
+                }
+                else
+                {
+                    job = queue.jobs.back();
+                    queue.jobs.pop_back();
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void runBatchWorker(const vector<EncodeJob> &jobs, WorkQueue *queues, size_t workers, size_t self, vector<int> &codes, size_t &bytes) const
+    {
+        size_t job = 0;
+        while (takeJob(queues, workers, self, job))
+        {
+            codes[job] = encodeFile(jobs[job].inputFilePath, jobs[job].outputFilePath, 1);
+            struct stat inputStat;
+            if (codes[job] == SUCCESS && stat(jobs[job].inputFilePath.c_str(), &inputStat) == 0)
+            {
+                bytes += static_cast<size_t>(inputStat.st_size);
+            }
+        }
+    }
+
+    int encodeFile(const string &inputFilePath, const string &outputFilePath, unsigned workers) const
     {
         if (inputFilePath.empty() || outputFilePath.empty())
         {
@@ -90,6 +509,23 @@ public:
             return ERROR_SAME_FILES;
         }
 
+        if (key.empty())
+        {
+            return ERROR_NO_KEY;
+        }
+
+        KeystreamCursor cursor = {keyState, 0};
+
+        if (mode == EncodeMode::MAPPED)
+        {
+            bool mapped = false;
+            int code = encodeMapped(inputFilePath, outputFilePath, cursor, workers, mapped);
+            if (mapped)
+            {
+                return code;
+            }
+        }
+
         ifstream inputFile(inputFilePath, ios::binary);
         if (!inputFile.is_open())
         {
@@ -103,73 +539,388 @@ public:
             return ERROR_OPEN_FILE;
         }
 
-        if (key.empty())
+        int code = encodeStream(inputFile, outputFile, cursor, workers);
+
+        inputFile.close();
+        outputFile.close();
+
+        return code;
+    }
+
+    void initState(Rc4State &state) const
+    {
+        for (int i = 0; i < 256; ++i)
         {
-            inputFile.close();
-            outputFile.close();
-            return ERROR_NO_KEY;
+            state.S[i] = static_cast<uint8_t>(i);
+        }
+
+        uint8_t j = 0;
+        for (int i = 0; i < 256; ++i)
+        {
+            j = static_cast<uint8_t>(j + state.S[i] + to_integer<uint8_t>(key[i % key.size()]));
+            swap(state.S[i], state.S[j]);
+        }
+        state.i = 0;
+        state.j = j;
+    }
+
+    static inline uint8_t rc4Step(uint32_t *S, uint8_t &i, uint8_t &j)
+    {
+        i = static_cast<uint8_t>(i + 1);
+        uint32_t si = S[i];
+        j = static_cast<uint8_t>(j + si);
+        uint32_t sj = S[j];
+        S[i] = sj;
+        S[j] = si;
+        return static_cast<uint8_t>(S[static_cast<uint8_t>(si + sj)]);
+    }
+
+    // The S-box is widened into a local cache-line aligned array for the duration of the call:
+    // word-sized entries avoid partial-register stalls, i/j stay in registers and wrap as uint8_t,
+    // and the compiler knows the output stores never alias the table.
+    static void generateKeystream(Rc4State &state, uint8_t *out, size_t length)
+    {
+        alignas(64) uint32_t S[256];
+        for (int k = 0; k < 256; ++k)
+        {
+            S[k] = state.S[k];
+        }
+        uint8_t i = state.i;
+        uint8_t j = state.j;
+
+        size_t n = 0;
+        for (; n + KEYSTREAM_BLOCK <= length; n += KEYSTREAM_BLOCK)
+        {
+            alignas(64) uint8_t block[KEYSTREAM_BLOCK];
+            for (size_t k = 0; k < KEYSTREAM_BLOCK; ++k)
+            {
+                block[k] = rc4Step(S, i, j);
+            }
+            memcpy(out + n, block, KEYSTREAM_BLOCK);
+        }
+        for (; n < length; ++n)
+        {
+            out[n] = rc4Step(S, i, j);
         }
 
-        vector<byte> S(256);
+        for (int k = 0; k < 256; ++k)
+        {
+            state.S[k] = static_cast<uint8_t>(S[k]);
+        }
+        state.i = i;
+        state.j = j;
+    }
+
+    void fillKeystream(KeystreamCursor &cursor, uint8_t *out, size_t length) const
+    {
+        if (cursor.position < prefix.size())
+        {
+            size_t cached = min(length, prefix.size() - cursor.position);
+            memcpy(out, prefix.data() + cursor.position, cached);
+            cursor.position += cached;
+            out += cached;
+            length -= cached;
+            if (cursor.position == prefix.size())
+            {
+                cursor.state = prefixState;
+            }
+        }
+        generateKeystream(cursor.state, out, length);
+        cursor.position += length;
+    }
+
+    static void skipKeystream(Rc4State &state, uint64_t length, uint8_t *scratch, size_t scratchSize)
+    {
+        while (length > 0)
+        {
+            size_t count = static_cast<size_t>(min<uint64_t>(length, scratchSize));
+            generateKeystream(state, scratch, count);
+            length -= count;
+        }
+    }
+
+    static void xorBlock(uint8_t *data, const uint8_t *keystream, size_t length)
+    {
+        size_t n = 0;
+#if defined(__AVX2__)
+        for (; n + 64 <= length; n += 64)
+        {
+            __m256i d0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + n));
+            __m256i d1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + n + 32));
+            __m256i k0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keystream + n));
+            __m256i k1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keystream + n + 32));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(data + n), _mm256_xor_si256(d0, k0));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(data + n + 32), _mm256_xor_si256(d1, k1));
+        }
+#elif defined(__SSE2__)
+        for (; n + 64 <= length; n += 64)
+        {
+            for (size_t lane = 0; lane < 64; lane += 16)
+            {
+                __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + n + lane));
+                __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keystream + n + lane));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(data + n + lane), _mm_xor_si128(d, k));
+            }
+        }
+#endif
+        for (; n < length; ++n)
+        {
+            data[n] ^= keystream[n];
+        }
+    }
+
+    static void xorParallel(uint8_t *data, const uint8_t *keystream, size_t length, unsigned workers)
+    {
+        if (workers < 2 || length < MIN_PARALLEL_XOR)
+        {
+            xorBlock(data, keystream, length);
+            return;
+        }
+
+        size_t chunk = (length + workers - 1) / workers;
+        vector<thread> threads;
+        unsigned started = 1;
         try
         {
-            for (int i = 0; i < 256; ++i)
+            threads.reserve(workers - 1);
+            for (; started < workers && started * chunk < length; ++started)
             {
-                S[i] = static_cast<byte>(i);
+                size_t begin = started * chunk;
+                threads.emplace_back(xorBlock, data + begin, keystream + begin, min(chunk, length - begin));
             }
         }
         catch (const exception &e)
         {
-            inputFile.close();
-            outputFile.close();
-            return ERROR_MEMORY_ALLOCATION;
+            // Chunks whose thread could not be started are XORed here; the running threads are still joined below.
+            for (unsigned w = started; w < workers && w * chunk < length; ++w)
+            {
+                size_t begin = w * chunk;
+                xorBlock(data + begin, keystream + begin, min(chunk, length - begin));
+            }
+        }
+        xorBlock(data, keystream, min(chunk, length));
+        for (thread &t : threads)
+        {
+            t.join();
         }
+    }
 
-        int j = 0;
-        for (int i = 0; i < 256; ++i)
+    static size_t readBlock(ifstream &inputFile, uint8_t *buffer, size_t length = BLOCK_SIZE)
+    {
+        inputFile.read(reinterpret_cast<char *>(buffer), static_cast<streamsize>(length));
+        return static_cast<size_t>(inputFile.gcount());
+    }
+
+    // Bytes between the read position and the end of the file, or BLOCK_SIZE when the stream cannot seek.
+    static size_t nextBlockLength(ifstream &inputFile)
+    {
+        streampos here = inputFile.tellg();
+        if (here != streampos(-1) && inputFile.seekg(0, ios::end))
         {
-            j = (j + to_integer<int>(S[i]) + to_integer<int>(key[i % key.size()])) % 256;
-            swap(S[i], S[j]);
+            streampos end = inputFile.tellg();
+            if (inputFile.seekg(here) && end != streampos(-1))
+            {
+                return min(BLOCK_SIZE, static_cast<size_t>(end - here));
+            }
         }
+        inputFile.clear(inputFile.rdstate() & ios::badbit);
+        return inputFile.peek() == char_traits<char>::eof() ? 0 : BLOCK_SIZE;
+    }
+
+    static unsigned workerCount()
+    {
+        unsigned cores = thread::hardware_concurrency();
+        // One core is kept for the keystream producer.
+        return cores > 2 ? cores - 1 : 1;
+    }
 
-        int i = 0, k = 0;
-        char byte_in;
-        char byte_out;
-        while (inputFile.get(byte_in))
+    // Double-buffered pipeline: while block N is XORed by the workers and written,
+    // block N+1 is read and its keystream is produced on separate threads (inline when workers == 1).
+    int encodeStream(ifstream &inputFile, ofstream &outputFile, KeystreamCursor &cursor, unsigned workers) const
+    {
+        unique_ptr<uint8_t[]> data[2];
+        unique_ptr<uint8_t[]> keystream[2];
+        try
+        {
+            data[0].reset(new uint8_t[BLOCK_SIZE]);
+            keystream[0].reset(new uint8_t[BLOCK_SIZE]);
+        }
+        catch (const bad_alloc &e)
         {
-            i = (i + 1) % 256;
-            j = (j + to_integer<int>(S[i])) % 256;
-            swap(S[i], S[j]);
-            k = to_integer<int>(S[(to_integer<int>(S[i]) + to_integer<int>(S[j])) % 256]);
+            return ERROR_MEMORY_ALLOCATION;
+        }
 
-            byte_out = byte_in ^ static_cast<char>(k);
+        size_t length[2] = {readBlock(inputFile, data[0].get()), 0};
+        if (inputFile.bad())
+        {
+            return ERROR_FILE_OPERATION;
+        }
 
-            if (!outputFile.put(byte_out))
+        if (length[0] < BLOCK_SIZE)
+        {
+            fillKeystream(cursor, keystream[0].get(), length[0]);
+            xorBlock(data[0].get(), keystream[0].get(), length[0]);
+            if (!outputFile.write(reinterpret_cast<const char *>(data[0].get()), length[0]))
             {
-                inputFile.close();
-                outputFile.close();
                 return ERROR_FILE_OPERATION;
             }
+            return SUCCESS;
         }
 
-        inputFile.close();
-        outputFile.close();
+        try
+        {
+            data[1].reset(new uint8_t[BLOCK_SIZE]);
+            keystream[1].reset(new uint8_t[BLOCK_SIZE]);
+        }
+        catch (const bad_alloc &e)
+        {
+            return ERROR_MEMORY_ALLOCATION;
+        }
+
+        fillKeystream(cursor, keystream[0].get(), BLOCK_SIZE);
+        launch policy = workers > 1 ? launch::async : launch::deferred;
+        int current = 0;
+        try
+        {
+            while (length[current] > 0)
+            {
+                int next = 1 - current;
+                // After a short block the input is exhausted; otherwise only as much keystream as the next block needs is produced.
+                size_t nextLength = length[current] == BLOCK_SIZE ? nextBlockLength(inputFile) : 0;
+                bool more = nextLength > 0;
+                future<size_t> nextRead;
+                future<void> nextKeystream;
+                if (more)
+                {
+                    nextRead = async(policy, readBlock, ref(inputFile), data[next].get(), nextLength);
+                    nextKeystream = async(policy, &Encoder::fillKeystream, this, ref(cursor), keystream[next].get(), nextLength);
+                }
+
+                xorParallel(data[current].get(), keystream[current].get(), length[current], workers);
+                bool written = static_cast<bool>(outputFile.write(reinterpret_cast<const char *>(data[current].get()), length[current]));
+
+                length[next] = more ? nextRead.get() : 0;
+                if (more)
+                {
+                    nextKeystream.get();
+                }
+                if (!written || inputFile.bad())
+                {
+                    return ERROR_FILE_OPERATION;
+                }
+                current = next;
+            }
+        }
+        catch (const system_error &e)
+        {
+            return ERROR_FILE_OPERATION;
+        }
+        catch (const bad_alloc &e)
+        {
+            return ERROR_MEMORY_ALLOCATION;
+        }
 
         return SUCCESS;
     }
 
-    int setKey(const vector<byte> &newKey)
+    // The keystream for the next block is produced straight into the output mapping
+    // while the workers XOR the input into the current one.
+    int applyKeystream(const uint8_t *input, uint8_t *output, size_t size, KeystreamCursor &cursor, unsigned workers) const
     {
-        if (newKey.empty())
+        fillKeystream(cursor, output, min(size, BLOCK_SIZE));
+        if (size <= BLOCK_SIZE)
         {
-            return ERROR_INVALID_ARGUMENT;
+            xorBlock(output, input, size);
+            return SUCCESS;
         }
-        key = newKey;
+
+        launch policy = workers > 1 ? launch::async : launch::deferred;
+        try
+        {
+            for (size_t offset = 0; offset < size; offset += BLOCK_SIZE)
+            {
+                size_t length = min(BLOCK_SIZE, size - offset);
+                size_t nextOffset = offset + length;
+                future<void> nextKeystream;
+                if (nextOffset < size)
+                {
+                    nextKeystream = async(policy, &Encoder::fillKeystream, this, ref(cursor), output + nextOffset, min(BLOCK_SIZE, size - nextOffset));
+                }
+
+                xorParallel(output + offset, input + offset, length, workers);
+
+                if (nextKeystream.valid())
+                {
+                    nextKeystream.get();
+                }
+            }
+        }
+        catch (const system_error &e)
+        {
+            return ERROR_FILE_OPERATION;
+        }
+
         return SUCCESS;
     }
 
-private:
-    vector<byte> key;
+    // Leaves mapped == false when the files cannot be mapped, so the caller can use the stream path.
+    int encodeMapped(const string &inputFilePath, const string &outputFilePath, KeystreamCursor &cursor, unsigned workers, bool &mapped) const
+    {
+        mapped = false;
+
+        struct stat outputStat;
+        if (stat(outputFilePath.c_str(), &outputStat) == 0 && !S_ISREG(outputStat.st_mode))
+        {
+            return SUCCESS;
+        }
+
+        FileMapping input;
+        input.fd = open(inputFilePath.c_str(), O_RDONLY);
+        if (input.fd < 0)
+        {
+            return SUCCESS;
+        }
+
+        struct stat inputStat;
+        if (fstat(input.fd, &inputStat) != 0 || !S_ISREG(inputStat.st_mode) || inputStat.st_size <= 0)
+        {
+            return SUCCESS;
+        }
+
+        size_t size = static_cast<size_t>(inputStat.st_size);
+        input.addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, input.fd, 0);
+        if (input.addr == MAP_FAILED)
+        {
+            return SUCCESS;
+        }
+        input.size = size;
+        madvise(input.addr, size, MADV_SEQUENTIAL);
+
+        mapped = true;
+
+        FileMapping output;
+        output.fd = open(outputFilePath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0666);
+        if (output.fd < 0)
+        {
+            return ERROR_OPEN_FILE;
+        }
+
+        // Reserving the blocks up front turns a full disk into an error code instead of SIGBUS.
+        int reserved = posix_fallocate(output.fd, 0, static_cast<off_t>(size));
+        if (reserved == ENOSPC || (reserved != 0 && ftruncate(output.fd, static_cast<off_t>(size)) != 0))
+        {
+            return ERROR_FILE_OPERATION;
+        }
+
+        output.addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, output.fd, 0);
+        if (output.addr == MAP_FAILED)
+        {
+            return ERROR_FILE_OPERATION;
+        }
+        output.size = size;
+
+        return applyKeystream(static_cast<const uint8_t *>(input.addr), static_cast<uint8_t *>(output.addr), size, cursor, workers);
+    }
 
     bool areFilesSame(const string &filePath1, const string &filePath2) const
     {
@@ -191,10 +942,272 @@ private:
     }
 };
 
-int main()
+// Manifest lines: <input path> <output path> <e|d>; blank lines and lines starting with '#' are skipped.
+int readManifest(const string &manifestPath, vector<EncodeJob> &jobs)
+{
+    ifstream manifest(manifestPath);
+    if (!manifest.is_open())
+    {
+        return ERROR_OPEN_FILE;
+    }
+
+    string line;
+    while (getline(manifest, line))
+    {
+        istringstream fields(line);
+        EncodeJob job;
+        string direction;
+        string extra;
+        if (!(fields >> job.inputFilePath) || job.inputFilePath[0] == '#')
+        {
+            continue;
+        }
+        if (!(fields >> job.outputFilePath >> direction) || (fields >> extra) || (direction != "e" && direction != "d"))
+        {
+            manifest.close();
+            return ERROR_INVALID_ARGUMENT;
+        }
+        job.encrypt = direction == "e";
+        try
+        {
+            jobs.push_back(job);
+        }
+        catch (const bad_alloc &e)
+        {
+            manifest.close();
+            return ERROR_MEMORY_ALLOCATION;
+        }
+    }
+
+    int code = manifest.bad() ? ERROR_FILE_OPERATION : SUCCESS;
+    manifest.close();
+    return code;
+}
+
+int runBatch(const Encoder &encoder, const string &manifestPath)
+{
+    vector<EncodeJob> jobs;
+    int code = readManifest(manifestPath, jobs);
+    if (code != SUCCESS)
+    {
+        logErrors(code);
+        return code;
+    }
+
+    BatchReport report;
+    code = encoder.encodeBatch(jobs, report);
+    for (size_t n = 0; n < report.codes.size(); ++n)
+    {
+        if (report.codes[n] != SUCCESS)
+        {
+            cerr << "Job " << n + 1 << " (" << jobs[n].inputFilePath << " -> " << jobs[n].outputFilePath << "): ";
+            logErrors(report.codes[n]);
+        }
+    }
+
+    double megabytes = report.bytesProcessed / 1048576.0;
+    cout << jobs.size() << " jobs, " << fixed << setprecision(2) << megabytes << " MiB in " << report.seconds << " s";
+    if (report.seconds > 0.0)
+    {
+        cout << " (" << megabytes / report.seconds << " MiB/s)";
+    }
+    cout << endl;
+
+    return code;
+}
+
+// The original byte-at-a-time RC4 loop, kept as the baseline for the kernel benchmark.
+void legacyEncodeBuffer(const vector<byte> &key, const char *input, char *output, size_t length)
+{
+    vector<byte> S(256);
+    for (int i = 0; i < 256; ++i)
+    {
+        S[i] = static_cast<byte>(i);
+    }
+
+    int j = 0;
+    for (int i = 0; i < 256; ++i)
+    {
+        j = (j + to_integer<int>(S[i]) + to_integer<int>(key[i % key.size()])) % 256;
+        swap(S[i], S[j]);
+    }
+
+    int i = 0, k = 0;
+    for (size_t n = 0; n < length; ++n)
+    {
+        i = (i + 1) % 256;
+        j = (j + to_integer<int>(S[i])) % 256;
+        swap(S[i], S[j]);
+        k = to_integer<int>(S[(to_integer<int>(S[i]) + to_integer<int>(S[j])) % 256]);
+        output[n] = input[n] ^ static_cast<char>(k);
+    }
+}
+
+uint64_t readCycleCounter()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+int runKernelBenchmark(const vector<byte> &key)
+{
+    const size_t length = 64 << 20;
+    vector<char> input;
+    vector<char> expected;
+    vector<uint8_t> actual;
+    try
+    {
+        input.resize(length);
+        expected.resize(length);
+        actual.resize(length);
+    }
+    catch (const bad_alloc &e)
+    {
+        return ERROR_MEMORY_ALLOCATION;
+    }
+    for (size_t n = 0; n < length; ++n)
+    {
+        input[n] = static_cast<char>(n * 131 + 7);
+    }
+
+    auto start = chrono::steady_clock::now();
+    uint64_t startCycles = readCycleCounter();
+    legacyEncodeBuffer(key, input.data(), expected.data(), length);
+    uint64_t legacyCycles = readCycleCounter() - startCycles;
+    chrono::duration<double> legacyTime = chrono::steady_clock::now() - start;
+
+    Encoder encoder(key);
+    memcpy(actual.data(), input.data(), length);
+    start = chrono::steady_clock::now();
+    startCycles = readCycleCounter();
+    int code = encoder.encodeBuffer(actual.data(), length);
+    uint64_t kernelCycles = readCycleCounter() - startCycles;
+    chrono::duration<double> kernelTime = chrono::steady_clock::now() - start;
+    if (code != SUCCESS)
+    {
+        return code;
+    }
+    if (memcmp(actual.data(), expected.data(), length) != 0)
+    {
+        cerr << "Kernel output differs from the byte-at-a-time loop." << endl;
+        return ERROR_FILE_OPERATION;
+    }
+
+#if defined(__AVX2__)
+    const char *xorKernel = "AVX2";
+#elif defined(__SSE2__)
+    const char *xorKernel = "SSE2";
+#else
+    const char *xorKernel = "scalar";
+#endif
+    cout << left << setw(28) << "kernel" << setw(14) << "cycles/byte" << "MiB/s" << endl;
+    cout << setw(28) << "std::byte loop" << setw(14) << fixed << setprecision(2) << static_cast<double>(legacyCycles) / length
+         << (length >> 20) / legacyTime.count() << endl;
+    cout << setw(28) << string("64-byte blocks + ") + xorKernel << setw(14) << static_cast<double>(kernelCycles) / length
+         << (length >> 20) / kernelTime.count() << endl;
+    return SUCCESS;
+}
+
+int runKeystreamCacheBenchmark(const vector<byte> &key)
+{
+    const size_t sizes[] = {1 << 10, 4 << 10, 16 << 10, 64 << 10};
+    const char *modes[] = {"KSA per file", "cached KSA state", "cached 64 KiB prefix"};
+    const int filesPerRun = 2000;
+
+    error_code ec;
+    filesystem::path dir = filesystem::temp_directory_path(ec) / "ex2_benchmark";
+    if (!ec)
+    {
+        filesystem::create_directories(dir, ec);
+    }
+    if (ec)
+    {
+        return ERROR_FILE_OPERATION;
+    }
+    string inputPath = (dir / "input.bin").string();
+    string outputPath = (dir / "output.bin").string();
+
+    Encoder encoder(key);
+    cout << left << setw(8) << "size" << setw(24) << "mode" << "files/sec" << endl;
+    for (size_t size : sizes)
+    {
+        ofstream input(inputPath, ios::binary);
+        for (size_t n = 0; n < size; ++n)
+        {
+            input.put(static_cast<char>(n * 131 + 7));
+        }
+        input.close();
+        if (!input)
+        {
+            filesystem::remove_all(dir, ec);
+            return ERROR_FILE_OPERATION;
+        }
+
+        for (int mode = 0; mode < 3; ++mode)
+        {
+            int code = encoder.setKeystreamCacheSize(mode == 2 ? 64 << 10 : 0);
+            auto start = chrono::steady_clock::now();
+            for (int n = 0; n < filesPerRun && code == SUCCESS; ++n)
+            {
+                if (mode == 0)
+                {
+                    code = encoder.setKey(key);
+                }
+                if (code == SUCCESS)
+                {
+                    code = encoder.encode(inputPath, outputPath, true);
+                }
+            }
+            if (code != SUCCESS)
+            {
+                filesystem::remove_all(dir, ec);
+                return code;
+            }
+            chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+            cout << left << setw(8) << to_string(size >> 10) + "K" << setw(24) << modes[mode]
+                 << fixed << setprecision(0) << filesPerRun / elapsed.count() << endl;
+        }
+    }
+
+    filesystem::remove_all(dir, ec);
+    return SUCCESS;
+}
+
+int main(int argc, char *argv[])
 {
     vector<byte> key = {byte(0x01), byte(0x23), byte(0x45), byte(0x67), byte(0x89), byte(0xAB), byte(0xCD), byte(0xEF)};
 
+    bool bench = argc == 2 && strcmp(argv[1], "--bench") == 0;
+    bool benchKernel = argc == 2 && strcmp(argv[1], "--bench-kernel") == 0;
+    bool batch = argc == 3 && strcmp(argv[1], "--batch") == 0;
+    if (argc > 1 && !bench && !benchKernel && !batch)
+    {
+        cerr << "Usage: " << argv[0] << " [--bench | --bench-kernel | --batch <manifest>]" << endl;
+        return ERROR_INVALID_ARGUMENT;
+    }
+    if (bench || benchKernel)
+    {
+        int code = bench ? runKeystreamCacheBenchmark(key) : runKernelBenchmark(key);
+        logErrors(code);
+        return code;
+    }
+    if (batch)
+    {
+        try
+        {
+            Encoder batchEncoder(key);
+            return runBatch(batchEncoder, argv[2]);
+        }
+        catch (const bad_alloc &e)
+        {
+            logErrors(ERROR_MEMORY_ALLOCATION);
+            return ERROR_MEMORY_ALLOCATION;
+        }
+    }
+
     Encoder *encoder = nullptr;
     try
     {
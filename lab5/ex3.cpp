@@ -3,6 +3,17 @@
 #include <algorithm>
 #include <limits>
 #include <vector>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <new>
+#include <stdexcept>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
@@ -11,7 +22,8 @@ enum class ret_type_t : int
     SUCCESS = 0,
     ERROR_MALLOC = -1,
     ERROR_ARGUMENTS = -2,
-    ERROR_INVALID_VALUE = -3
+    ERROR_INVALID_VALUE = -3,
+    ERROR_BUFFER_TOO_SMALL = -4
 };
 
 void logError(ret_type_t code)
@@ -33,6 +45,11 @@ void logError(ret_type_t code)
         cerr << "Error: Invalid input value." << endl;
         break;
     }
+    case ret_type_t::ERROR_BUFFER_TOO_SMALL:
+    {
+        cerr << "Error: Output buffer is too small." << endl;
+        break;
+    }
     default:
     {
         cerr << "Error: Unknown error." << endl;
@@ -65,6 +82,30 @@ unsigned int ultimateDec(unsigned int n)
     return n;
 }
 
+struct binary_chars_result
+{
+    char *ptr;
+    ret_type_t code;
+};
+
+// Eight binary digits for every byte value, most significant bit first.
+const array<array<char, 8>, 256> &binary_digit_table()
+{
+    static constexpr array<array<char, 8>, 256> table = []
+    {
+        array<array<char, 8>, 256> digits{};
+        for (size_t byte = 0; byte < digits.size(); ++byte)
+        {
+            for (size_t bit = 0; bit < 8; ++bit)
+            {
+                digits[byte][bit] = ((byte >> (7 - bit)) & 1) ? '1' : '0';
+            }
+        }
+        return digits;
+    }();
+    return table;
+}
+
 class logical_values_array
 {
 private:
@@ -119,32 +160,32 @@ public:
 
     logical_values_array implication(const logical_values_array &other) const
     {
-        return ~(*this) | other;
+        return logical_values_array(~value | other.value);
     }
 
     logical_values_array coimplication(const logical_values_array &other) const
     {
-        return ~(*this ^ other);
+        return logical_values_array(~(value ^ other.value));
     }
 
     logical_values_array operator^(const logical_values_array &other) const
     {
-        return logical_values_array((value & ~other.value) | (~value & other.value));
+        return logical_values_array(value ^ other.value);
     }
 
     logical_values_array equalant(const logical_values_array &other) const
     {
-        return ~(*this ^ other);
+        return logical_values_array(~(value ^ other.value));
     }
 
     logical_values_array pearce(const logical_values_array &other) const
     {
-        return ~(*this | other);
+        return logical_values_array(~(value | other.value));
     }
 
     logical_values_array sheffer(const logical_values_array &other) const
     {
-        return ~(*this & other);
+        return logical_values_array(~(value & other.value));
     }
 
     static bool equals(const logical_values_array &a, const logical_values_array &b)
@@ -161,97 +202,1637 @@ public:
         return (value >> position) & 1;
     }
 
+    static constexpr size_t max_binary_digits = sizeof(unsigned int) * 8;
+
+    // Writes the binary digits without leading zeros ("0" for zero) into [first, last) and does not
+    // terminate them, like std::to_chars. On success ptr points one past the last digit written.
+    binary_chars_result to_binary_chars(char *first, char *last) const
+    {
+        if (first == nullptr || last < first)
+        {
+            return {first, ret_type_t::ERROR_INVALID_VALUE};
+        }
+        size_t width = value == 0 ? 1 : max_binary_digits - static_cast<size_t>(countl_zero(value));
+        if (static_cast<size_t>(last - first) < width)
+        {
+            return {last, ret_type_t::ERROR_BUFFER_TOO_SMALL};
+        }
+
+        const array<array<char, 8>, 256> &table = binary_digit_table();
+        size_t bytes = (width + 7) / 8;
+        size_t leading = width - (bytes - 1) * 8;
+        const array<char, 8> &top = table[(value >> ((bytes - 1) * 8)) & 0xFF];
+        memcpy(first, top.data() + 8 - leading, leading);
+        char *position = first + leading;
+        for (size_t i = bytes - 1; i-- > 0;)
+        {
+            memcpy(position, table[(value >> (i * 8)) & 0xFF].data(), 8);
+            position += 8;
+        }
+        return {position, ret_type_t::SUCCESS};
+    }
+
+    // destiny must hold at least max_binary_digits + 1 characters.
     ret_type_t to_binary_string(char *destiny) const
     {
         if (destiny == nullptr)
         {
             return ret_type_t::ERROR_INVALID_VALUE;
         }
-        unsigned int number = value;
-        vector<char> buffer;
+        binary_chars_result result = to_binary_chars(destiny, destiny + max_binary_digits);
+        if (result.code != ret_type_t::SUCCESS)
+        {
+            return result.code;
+        }
+        *result.ptr = '\0';
+        return ret_type_t::SUCCESS;
+    }
 
-        if (number == 0)
+    // Formats every value into one contiguous buffer, each followed by separator, and terminates the
+    // text. Needs at most count * (max_binary_digits + 1) + 1 characters.
+    static binary_chars_result to_binary_strings(const logical_values_array *values, const size_t count,
+                                                 const char separator, char *first, char *last)
+    {
+        if ((values == nullptr && count != 0) || first == nullptr || last <= first)
         {
-            buffer.push_back('0');
+            return {first, ret_type_t::ERROR_INVALID_VALUE};
         }
-        else
+        char *position = first;
+        for (size_t i = 0; i < count; ++i)
         {
-            while (number > 0)
+            binary_chars_result result = values[i].to_binary_chars(position, last - 1);
+            if (result.code != ret_type_t::SUCCESS || result.ptr == last - 1)
             {
-                buffer.push_back((number & 1) ? '1' : '0');
-                number >>= 1;
+                return {result.ptr, ret_type_t::ERROR_BUFFER_TOO_SMALL};
             }
-            reverse(buffer.begin(), buffer.end());
+            position = result.ptr;
+            *position++ = separator;
         }
+        *position = '\0';
+        return {position, ret_type_t::SUCCESS};
+    }
+};
 
-        if (buffer.size() + 1 > numeric_limits<ptrdiff_t>::max())
-        {
-            return ret_type_t::ERROR_MALLOC;
-        }
+enum class logical_operation
+{
+    CONJUNCTION,
+    DISJUNCTION,
+    EXCLUSIVE_OR,
+    IMPLICATION,
+    COIMPLICATION,
+    EQUALANT,
+    PEARCE,
+    SHEFFER,
+    NEGATION
+};
+
+// Word kernels: each operation has a scalar form and, when compiled with AVX2, a 256-bit form.
+struct conjunction_kernel
+{
+    static uint64_t apply(uint64_t a, uint64_t b) { return a & b; }
+#if defined(__AVX2__)
+    static __m256i apply(__m256i a, __m256i b) { return _mm256_and_si256(a, b); }
+#endif
+};
+
+struct disjunction_kernel
+{
+    static uint64_t apply(uint64_t a, uint64_t b) { return a | b; }
+#if defined(__AVX2__)
+    static __m256i apply(__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+#endif
+};
+
+struct exclusive_or_kernel
+{
+    static uint64_t apply(uint64_t a, uint64_t b) { return a ^ b; }
+#if defined(__AVX2__)
+    static __m256i apply(__m256i a, __m256i b) { return _mm256_xor_si256(a, b); }
+#endif
+};
+
+struct implication_kernel
+{
+    static uint64_t apply(uint64_t a, uint64_t b) { return ~a | b; }
+#if defined(__AVX2__)
+    static __m256i apply(__m256i a, __m256i b) { return _mm256_or_si256(_mm256_xor_si256(a, _mm256_set1_epi64x(-1)), b); }
+#endif
+};
+
+struct equalant_kernel
+{
+    static uint64_t apply(uint64_t a, uint64_t b) { return ~(a ^ b); }
+#if defined(__AVX2__)
+    static __m256i apply(__m256i a, __m256i b) { return _mm256_xor_si256(_mm256_xor_si256(a, b), _mm256_set1_epi64x(-1)); }
+#endif
+};
+
+struct pearce_kernel
+{
+    static uint64_t apply(uint64_t a, uint64_t b) { return ~(a | b); }
+#if defined(__AVX2__)
+    static __m256i apply(__m256i a, __m256i b) { return _mm256_xor_si256(_mm256_or_si256(a, b), _mm256_set1_epi64x(-1)); }
+#endif
+};
+
+struct sheffer_kernel
+{
+    static uint64_t apply(uint64_t a, uint64_t b) { return ~(a & b); }
+#if defined(__AVX2__)
+    static __m256i apply(__m256i a, __m256i b) { return _mm256_xor_si256(_mm256_and_si256(a, b), _mm256_set1_epi64x(-1)); }
+#endif
+};
+
+
+class logical_values_vector;
+
+template <typename Expression>
+class logical_expression;
+
+template <typename Kernel, typename Left, typename Right>
+class binary_expression;
+
+template <typename Operand>
+class negation_expression;
+
+// Vectors are held by reference inside an expression, intermediate nodes by value.
+template <typename Expression>
+struct expression_operand
+{
+    using type = Expression;
+};
+
+template <>
+struct expression_operand<logical_values_vector>
+{
+    using type = const logical_values_vector &;
+};
+
+// Lazy boolean expression over logical_values_vector operands. Nothing is computed until the
+// expression is assigned to a vector, which then evaluates the whole tree in a single pass.
+template <typename Expression>
+class logical_expression
+{
+public:
+    const Expression &self() const
+    {
+        return static_cast<const Expression &>(*this);
+    }
+
+    negation_expression<Expression> operator~() const
+    {
+        return negation_expression<Expression>(self());
+    }
+
+    template <typename Other>
+    binary_expression<conjunction_kernel, Expression, Other> operator&(const logical_expression<Other> &other) const
+    {
+        return binary_expression<conjunction_kernel, Expression, Other>(self(), other.self());
+    }
+
+    template <typename Other>
+    binary_expression<disjunction_kernel, Expression, Other> operator|(const logical_expression<Other> &other) const
+    {
+        return binary_expression<disjunction_kernel, Expression, Other>(self(), other.self());
+    }
+
+    template <typename Other>
+    binary_expression<exclusive_or_kernel, Expression, Other> operator^(const logical_expression<Other> &other) const
+    {
+        return binary_expression<exclusive_or_kernel, Expression, Other>(self(), other.self());
+    }
+
+    template <typename Other>
+    binary_expression<implication_kernel, Expression, Other> implication(const logical_expression<Other> &other) const
+    {
+        return binary_expression<implication_kernel, Expression, Other>(self(), other.self());
+    }
+
+    template <typename Other>
+    binary_expression<equalant_kernel, Expression, Other> coimplication(const logical_expression<Other> &other) const
+    {
+        return binary_expression<equalant_kernel, Expression, Other>(self(), other.self());
+    }
+
+    template <typename Other>
+    binary_expression<equalant_kernel, Expression, Other> equalant(const logical_expression<Other> &other) const
+    {
+        return binary_expression<equalant_kernel, Expression, Other>(self(), other.self());
+    }
+
+    template <typename Other>
+    binary_expression<pearce_kernel, Expression, Other> pearce(const logical_expression<Other> &other) const
+    {
+        return binary_expression<pearce_kernel, Expression, Other>(self(), other.self());
+    }
+
+    template <typename Other>
+    binary_expression<sheffer_kernel, Expression, Other> sheffer(const logical_expression<Other> &other) const
+    {
+        return binary_expression<sheffer_kernel, Expression, Other>(self(), other.self());
+    }
+};
+
+template <typename Kernel, typename Left, typename Right>
+class binary_expression : public logical_expression<binary_expression<Kernel, Left, Right>>
+{
+private:
+    typename expression_operand<Left>::type left;
+    typename expression_operand<Right>::type right;
 
-        for (size_t i = 0; i < buffer.size(); ++i)
+public:
+    binary_expression(const Left &l, const Right &r) : left(l), right(r)
+    {
+        if (left.size() != right.size())
         {
-            destiny[i] = buffer[i];
+            throw invalid_argument("Logical vectors must have the same size.");
         }
-        destiny[buffer.size()] = '\0';
+    }
 
-        return ret_type_t::SUCCESS;
+    size_t size() const
+    {
+        return left.size();
+    }
+
+    size_t storage_words() const
+    {
+        return left.storage_words();
     }
+
+    uint64_t word(const size_t index) const
+    {
+        return Kernel::apply(left.word(index), right.word(index));
+    }
+
+#if defined(__AVX2__)
+    __m256i block(const size_t index) const
+    {
+        return Kernel::apply(left.block(index), right.block(index));
+    }
+#endif
 };
 
-int main(int argc, char *argv[])
+template <typename Operand>
+class negation_expression : public logical_expression<negation_expression<Operand>>
 {
-    if (argc > 1)
+private:
+    typename expression_operand<Operand>::type operand;
+
+public:
+    explicit negation_expression(const Operand &o) : operand(o) {}
+
+    size_t size() const
     {
-        logError(ret_type_t::ERROR_ARGUMENTS);
-        cerr << "Usage: " << argv[0] << " (no arguments expected)" << endl;
-        return static_cast<int>(ret_type_t::ERROR_ARGUMENTS);
+        return operand.size();
     }
 
-    logical_values_array a(5);
-    logical_values_array b(3);
+    size_t storage_words() const
+    {
+        return operand.storage_words();
+    }
 
-    cout << "a: " << a.get_value() << endl;
-    cout << "b: " << b.get_value() << endl;
+    uint64_t word(const size_t index) const
+    {
+        return ~operand.word(index);
+    }
 
-    cout << "a & b: " << (a & b).get_value() << endl;
-    cout << "a | b: " << (a | b).get_value() << endl;
-    cout << "a ^ b: " << (a ^ b).get_value() << endl;
-    cout << "~a: " << (~a).get_value() << endl;
-    cout << "a -> b: " << a.implication(b).get_value() << endl;
-    cout << "a <-> b: " << a.coimplication(b).get_value() << endl;
-    cout << "a == b: " << a.equalant(b).get_value() << endl;
-    cout << "a ↓ b: " << a.pearce(b).get_value() << endl;
-    cout << "a | b: " << a.sheffer(b).get_value() << endl;
+#if defined(__AVX2__)
+    __m256i block(const size_t index) const
+    {
+        return _mm256_xor_si256(operand.block(index), _mm256_set1_epi64x(-1));
+    }
+#endif
+};
 
-    cout << "Bit 0 of a: " << a.get_bit(0) << endl;
-    cout << "Bit 1 of a: " << a.get_bit(1) << endl;
-    cout << "Bit 2 of a: " << a.get_bit(2) << endl;
+// Runtime-sized truth vector stored as 32-byte aligned 64-bit words. Storage is padded to whole
+// 256-bit blocks so the kernels never need a tail loop; bits past size() are always kept at zero.
+class logical_values_vector : public logical_expression<logical_values_vector>
+{
+private:
+    static constexpr size_t WORD_BITS = 64;
+    static constexpr size_t BLOCK_WORDS = 4;
+    static constexpr size_t ALIGNMENT = 32;
 
-    cout << "Bit 0 of b: " << b.get_bit(0) << endl;
-    cout << "Bit 1 of b: " << b.get_bit(1) << endl;
+    size_t bit_count;
+    size_t word_count;
+    uint64_t *words;
 
-    size_t max_binary_str_len = sizeof(unsigned int) * 8 + 1;
-    char *binary_str = new char[max_binary_str_len];
-    if (!binary_str)
+    static size_t padded_words(size_t bits)
     {
-        logError(ret_type_t::ERROR_MALLOC);
-        return static_cast<int>(ret_type_t::ERROR_MALLOC);
+        size_t used = (bits + WORD_BITS - 1) / WORD_BITS;
+        return (used + BLOCK_WORDS - 1) / BLOCK_WORDS * BLOCK_WORDS;
     }
 
-    ret_type_t code = a.to_binary_string(binary_str);
-    if (code != ret_type_t::SUCCESS)
+    static uint64_t *allocate_words(size_t count)
     {
-        logError(code);
-        delete[] binary_str;
-        return static_cast<int>(code);
+        if (count == 0)
+        {
+            return nullptr;
+        }
+        return static_cast<uint64_t *>(::operator new[](count * sizeof(uint64_t), align_val_t(ALIGNMENT), nothrow));
     }
-    cout << "Binary representation of a: " << binary_str << endl;
-    delete[] binary_str;
 
-    logical_values_array c(5);
-    cout << "a == c: " << logical_values_array::equals(a, c) << endl;
-    cout << "a == b: " << logical_values_array::equals(a, b) << endl;
+    static void release_words(uint64_t *memory)
+    {
+        if (memory != nullptr)
+        {
+            ::operator delete[](memory, align_val_t(ALIGNMENT));
+        }
+    }
+
+    void clear_unused_bits()
+    {
+        size_t used = (bit_count + WORD_BITS - 1) / WORD_BITS;
+        if (bit_count % WORD_BITS != 0)
+        {
+            words[used - 1] &= (uint64_t(1) << (bit_count % WORD_BITS)) - 1;
+        }
+        for (size_t i = used; i < word_count; ++i)
+        {
+            words[i] = 0;
+        }
+    }
+
+    template <typename Expression>
+    void store(const Expression &expression)
+    {
+#if defined(__AVX2__)
+        for (size_t i = 0; i < word_count; i += BLOCK_WORDS)
+        {
+            _mm256_store_si256(reinterpret_cast<__m256i *>(words + i), expression.block(i));
+        }
+#else
+        for (size_t i = 0; i < word_count; ++i)
+        {
+            words[i] = expression.word(i);
+        }
+#endif
+        clear_unused_bits();
+    }
+
+public:
+    logical_values_vector() : bit_count(0), word_count(0), words(nullptr) {}
+
+    explicit logical_values_vector(size_t bits, bool fill = false)
+        : bit_count(bits), word_count(padded_words(bits)), words(allocate_words(word_count))
+    {
+        if (word_count != 0 && words == nullptr)
+        {
+            throw bad_alloc();
+        }
+        for (size_t i = 0; i < word_count; ++i)
+        {
+            words[i] = fill ? ~uint64_t(0) : 0;
+        }
+        if (word_count != 0)
+        {
+            clear_unused_bits();
+        }
+    }
+
+    logical_values_vector(const logical_values_vector &other)
+        : bit_count(other.bit_count), word_count(other.word_count), words(allocate_words(other.word_count))
+    {
+        if (word_count != 0 && words == nullptr)
+        {
+            throw bad_alloc();
+        }
+        for (size_t i = 0; i < word_count; ++i)
+        {
+            words[i] = other.words[i];
+        }
+    }
+
+    logical_values_vector(logical_values_vector &&other) noexcept
+        : bit_count(other.bit_count), word_count(other.word_count), words(other.words)
+    {
+        other.bit_count = 0;
+        other.word_count = 0;
+        other.words = nullptr;
+    }
+
+    ~logical_values_vector()
+    {
+        release_words(words);
+    }
+
+    logical_values_vector &operator=(const logical_values_vector &other)
+    {
+        if (this != &other)
+        {
+            logical_values_vector copy(other);
+            swap(bit_count, copy.bit_count);
+            swap(word_count, copy.word_count);
+            swap(words, copy.words);
+        }
+        return *this;
+    }
+
+    logical_values_vector &operator=(logical_values_vector &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release_words(words);
+            bit_count = other.bit_count;
+            word_count = other.word_count;
+            words = other.words;
+            other.bit_count = 0;
+            other.word_count = 0;
+            other.words = nullptr;
+        }
+        return *this;
+    }
+
+    size_t size() const
+    {
+        return bit_count;
+    }
+
+    const uint64_t *data() const
+    {
+        return words;
+    }
+
+    bool get_bit(const size_t position) const
+    {
+        if (position >= bit_count)
+        {
+            return false;
+        }
+        return (words[position / WORD_BITS] >> (position % WORD_BITS)) & 1;
+    }
+
+    ret_type_t set_bit(const size_t position, const bool bit)
+    {
+        if (position >= bit_count)
+        {
+            return ret_type_t::ERROR_INVALID_VALUE;
+        }
+        uint64_t mask = uint64_t(1) << (position % WORD_BITS);
+        words[position / WORD_BITS] = bit ? (words[position / WORD_BITS] | mask) : (words[position / WORD_BITS] & ~mask);
+        return ret_type_t::SUCCESS;
+    }
+
+    size_t storage_words() const
+    {
+        return word_count;
+    }
+
+    uint64_t word(const size_t index) const
+    {
+        return words[index];
+    }
+
+#if defined(__AVX2__)
+    __m256i block(const size_t index) const
+    {
+        return _mm256_load_si256(reinterpret_cast<const __m256i *>(words + index));
+    }
+#endif
+
+    // Evaluates the expression into this vector in one pass, reusing the storage when the size
+    // already matches. Operands may alias the destination.
+    template <typename Expression>
+    ret_type_t assign(const logical_expression<Expression> &expression)
+    {
+        const Expression &tree = expression.self();
+        if (bit_count != tree.size())
+        {
+            logical_values_vector resized;
+            resized.words = allocate_words(tree.storage_words());
+            if (tree.storage_words() != 0 && resized.words == nullptr)
+            {
+                return ret_type_t::ERROR_MALLOC;
+            }
+            resized.bit_count = tree.size();
+            resized.word_count = tree.storage_words();
+            resized.store(tree);
+            *this = move(resized);
+            return ret_type_t::SUCCESS;
+        }
+        store(tree);
+        return ret_type_t::SUCCESS;
+    }
+
+    template <typename Expression>
+    logical_values_vector(const logical_expression<Expression> &expression) : logical_values_vector()
+    {
+        if (assign(expression) != ret_type_t::SUCCESS)
+        {
+            throw bad_alloc();
+        }
+    }
+
+    template <typename Expression>
+    logical_values_vector &operator=(const logical_expression<Expression> &expression)
+    {
+        if (assign(expression) != ret_type_t::SUCCESS)
+        {
+            throw bad_alloc();
+        }
+        return *this;
+    }
+
+    // Writes `a op b` (or `~a` for NEGATION, where b is ignored) into destiny.
+    static ret_type_t evaluate(const logical_operation operation, const logical_values_vector &a,
+                               const logical_values_vector &b, logical_values_vector &destiny)
+    {
+        if (operation != logical_operation::NEGATION && a.bit_count != b.bit_count)
+        {
+            return ret_type_t::ERROR_INVALID_VALUE;
+        }
+        switch (operation)
+        {
+        case logical_operation::CONJUNCTION:
+            return destiny.assign(a & b);
+        case logical_operation::DISJUNCTION:
+            return destiny.assign(a | b);
+        case logical_operation::EXCLUSIVE_OR:
+            return destiny.assign(a ^ b);
+        case logical_operation::IMPLICATION:
+            return destiny.assign(a.implication(b));
+        case logical_operation::COIMPLICATION:
+            return destiny.assign(a.coimplication(b));
+        case logical_operation::EQUALANT:
+            return destiny.assign(a.equalant(b));
+        case logical_operation::PEARCE:
+            return destiny.assign(a.pearce(b));
+        case logical_operation::SHEFFER:
+            return destiny.assign(a.sheffer(b));
+        case logical_operation::NEGATION:
+            return destiny.assign(~a);
+        }
+        return ret_type_t::ERROR_INVALID_VALUE;
+    }
+
+    // Number of set bits. The AVX2 path counts nibbles with a 16-entry shuffle table (Mula's method).
+    size_t count() const
+    {
+        size_t total = 0;
+        size_t i = 0;
+#if defined(__AVX2__)
+        const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                               0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i low_nibbles = _mm256_set1_epi8(0x0F);
+        __m256i sums = _mm256_setzero_si256();
+        for (; i < word_count; i += BLOCK_WORDS)
+        {
+            __m256i block = _mm256_load_si256(reinterpret_cast<const __m256i *>(words + i));
+            __m256i low = _mm256_shuffle_epi8(table, _mm256_and_si256(block, low_nibbles));
+            __m256i high = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(block, 4), low_nibbles));
+            sums = _mm256_add_epi64(sums, _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256()));
+        }
+        alignas(32) uint64_t lanes[BLOCK_WORDS];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), sums);
+        total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+        for (; i < word_count; ++i)
+        {
+            total += static_cast<size_t>(popcount(words[i]));
+        }
+        return total;
+    }
+
+    bool any() const
+    {
+        size_t i = 0;
+#if defined(__AVX2__)
+        __m256i accumulated = _mm256_setzero_si256();
+        for (; i < word_count; i += BLOCK_WORDS)
+        {
+            accumulated = _mm256_or_si256(accumulated, _mm256_load_si256(reinterpret_cast<const __m256i *>(words + i)));
+        }
+        return !_mm256_testz_si256(accumulated, accumulated);
+#else
+        uint64_t accumulated = 0;
+        for (; i < word_count; ++i)
+        {
+            accumulated |= words[i];
+        }
+        return accumulated != 0;
+#endif
+    }
+
+    bool all() const
+    {
+        size_t full_words = bit_count / WORD_BITS;
+        size_t i = 0;
+#if defined(__AVX2__)
+        __m256i block_accumulated = _mm256_set1_epi64x(-1);
+        for (; i + BLOCK_WORDS <= full_words; i += BLOCK_WORDS)
+        {
+            block_accumulated = _mm256_and_si256(block_accumulated, _mm256_load_si256(reinterpret_cast<const __m256i *>(words + i)));
+        }
+        if (!_mm256_testc_si256(block_accumulated, _mm256_set1_epi64x(-1)))
+        {
+            return false;
+        }
+#endif
+        for (; i < full_words; ++i)
+        {
+            if (words[i] != ~uint64_t(0))
+            {
+                return false;
+            }
+        }
+        if (bit_count % WORD_BITS != 0)
+        {
+            uint64_t mask = (uint64_t(1) << (bit_count % WORD_BITS)) - 1;
+            return words[full_words] == mask;
+        }
+        return true;
+    }
+
+    bool none() const
+    {
+        return !any();
+    }
+
+    static bool equals(const logical_values_vector &a, const logical_values_vector &b)
+    {
+        if (a.bit_count != b.bit_count)
+        {
+            return false;
+        }
+        for (size_t i = 0; i < a.word_count; ++i)
+        {
+            if (a.words[i] != b.words[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+struct formula_machine
+{
+    static constexpr size_t MAX_STACK_DEPTH = 64;
+
+    unsigned int stack[MAX_STACK_DEPTH];
+    size_t top;
+    const logical_values_array *inputs;
+};
+
+using formula_handler = void (*)(formula_machine &, uint32_t);
+
+struct formula_instruction
+{
+    formula_handler handler;
+    uint32_t operand;
+};
+
+// Compiles an infix formula over named logical_values_array variables into flat bytecode. Every
+// instruction is a handler pointer plus operand, dispatched from one loop, and each evaluation
+// computes all 32 bit lanes of the inputs at once.
+//
+// Syntax, loosest binding first: a <-> b, a -> b (right associative), a | b, a ^ b, a & b, ~a,
+// constants 0 and 1, parentheses, and implication/coimplication/equalant/pearce/sheffer(a, b).
+// Formulas with at most MAX_ANF_VARIABLES variables are rewritten to their algebraic normal form
+// (an xor of conjunctions) when that needs fewer instructions than the parsed tree.
+class logical_formula
+{
+public:
+    static constexpr size_t MAX_ANF_VARIABLES = 16;
+    static constexpr size_t MAX_NESTING = 256;
+
+private:
+    enum class node_kind
+    {
+        CONSTANT,
+        VARIABLE,
+        NEGATION,
+        BINARY
+    };
+
+    struct formula_node
+    {
+        node_kind kind;
+        logical_operation operation;
+        size_t left = 0;
+        size_t right = 0;
+        uint32_t value;
+    };
+
+    struct parser_state
+    {
+        const string &text;
+        size_t position;
+        size_t nesting;
+        vector<formula_node> &nodes;
+        vector<string> &variables;
+    };
+
+    vector<string> variables;
+    vector<formula_instruction> program;
+    bool minimized = false;
+
+    static void push_constant(formula_machine &machine, const uint32_t value)
+    {
+        machine.stack[machine.top++] = value ? ~0u : 0u;
+    }
+
+    static void push_variable(formula_machine &machine, const uint32_t index)
+    {
+        machine.stack[machine.top++] = machine.inputs[index].get_value();
+    }
+
+    static void and_variable(formula_machine &machine, const uint32_t index)
+    {
+        machine.stack[machine.top - 1] &= machine.inputs[index].get_value();
+    }
+
+    static void negate(formula_machine &machine, uint32_t)
+    {
+        machine.stack[machine.top - 1] = ~machine.stack[machine.top - 1];
+    }
+
+    static void conjunction(formula_machine &machine, uint32_t)
+    {
+        --machine.top;
+        machine.stack[machine.top - 1] &= machine.stack[machine.top];
+    }
+
+    static void disjunction(formula_machine &machine, uint32_t)
+    {
+        --machine.top;
+        machine.stack[machine.top - 1] |= machine.stack[machine.top];
+    }
+
+    static void exclusive_or(formula_machine &machine, uint32_t)
+    {
+        --machine.top;
+        machine.stack[machine.top - 1] ^= machine.stack[machine.top];
+    }
+
+    static void implication(formula_machine &machine, uint32_t)
+    {
+        --machine.top;
+        machine.stack[machine.top - 1] = ~machine.stack[machine.top - 1] | machine.stack[machine.top];
+    }
+
+    static void equalant(formula_machine &machine, uint32_t)
+    {
+        --machine.top;
+        machine.stack[machine.top - 1] = ~(machine.stack[machine.top - 1] ^ machine.stack[machine.top]);
+    }
+
+    static void pearce(formula_machine &machine, uint32_t)
+    {
+        --machine.top;
+        machine.stack[machine.top - 1] = ~(machine.stack[machine.top - 1] | machine.stack[machine.top]);
+    }
+
+    static void sheffer(formula_machine &machine, uint32_t)
+    {
+        --machine.top;
+        machine.stack[machine.top - 1] = ~(machine.stack[machine.top - 1] & machine.stack[machine.top]);
+    }
+
+    static formula_handler binary_handler(const logical_operation operation)
+    {
+        switch (operation)
+        {
+        case logical_operation::CONJUNCTION:
+            return conjunction;
+        case logical_operation::DISJUNCTION:
+            return disjunction;
+        case logical_operation::EXCLUSIVE_OR:
+            return exclusive_or;
+        case logical_operation::IMPLICATION:
+            return implication;
+        case logical_operation::PEARCE:
+            return pearce;
+        case logical_operation::SHEFFER:
+            return sheffer;
+        default:
+            return equalant;
+        }
+    }
+
+    static void skip_spaces(parser_state &state)
+    {
+        while (state.position < state.text.size() && isspace(static_cast<unsigned char>(state.text[state.position])))
+        {
+            ++state.position;
+        }
+    }
+
+    static bool accept(parser_state &state, const char *token)
+    {
+        skip_spaces(state);
+        size_t length = strlen(token);
+        if (state.text.compare(state.position, length, token) != 0)
+        {
+            return false;
+        }
+        state.position += length;
+        return true;
+    }
+
+    static size_t add_node(parser_state &state, const node_kind kind, const logical_operation operation,
+                           const size_t left, const size_t right, const uint32_t value)
+    {
+        state.nodes.push_back({kind, operation, left, right, value});
+        return state.nodes.size() - 1;
+    }
+
+    static ret_type_t parse_equivalence(parser_state &state, size_t &node)
+    {
+        if (++state.nesting > MAX_NESTING)
+        {
+            return ret_type_t::ERROR_INVALID_VALUE;
+        }
+        ret_type_t code = parse_implication(state, node);
+        while (code == ret_type_t::SUCCESS && accept(state, "<->"))
+        {
+            size_t right = 0;
+            code = parse_implication(state, right);
+            node = add_node(state, node_kind::BINARY, logical_operation::EQUALANT, node, right, 0);
+        }
+        --state.nesting;
+        return code;
+    }
+
+    static ret_type_t parse_implication(parser_state &state, size_t &node)
+    {
+        ret_type_t code = parse_disjunction(state, node);
+        if (code == ret_type_t::SUCCESS && accept(state, "->"))
+        {
+            if (++state.nesting > MAX_NESTING)
+            {
+                return ret_type_t::ERROR_INVALID_VALUE;
+            }
+            size_t right = 0;
+            code = parse_implication(state, right);
+            node = add_node(state, node_kind::BINARY, logical_operation::IMPLICATION, node, right, 0);
+            --state.nesting;
+        }
+        return code;
+    }
+
+    static ret_type_t parse_disjunction(parser_state &state, size_t &node)
+    {
+        ret_type_t code = parse_exclusive(state, node);
+        while (code == ret_type_t::SUCCESS && accept(state, "|"))
+        {
+            size_t right = 0;
+            code = parse_exclusive(state, right);
+            node = add_node(state, node_kind::BINARY, logical_operation::DISJUNCTION, node, right, 0);
+        }
+        return code;
+    }
+
+    static ret_type_t parse_exclusive(parser_state &state, size_t &node)
+    {
+        ret_type_t code = parse_conjunction(state, node);
+        while (code == ret_type_t::SUCCESS && accept(state, "^"))
+        {
+            size_t right = 0;
+            code = parse_conjunction(state, right);
+            node = add_node(state, node_kind::BINARY, logical_operation::EXCLUSIVE_OR, node, right, 0);
+        }
+        return code;
+    }
+
+    static ret_type_t parse_conjunction(parser_state &state, size_t &node)
+    {
+        ret_type_t code = parse_unary(state, node);
+        while (code == ret_type_t::SUCCESS && accept(state, "&"))
+        {
+            size_t right = 0;
+            code = parse_unary(state, right);
+            node = add_node(state, node_kind::BINARY, logical_operation::CONJUNCTION, node, right, 0);
+        }
+        return code;
+    }
+
+    static ret_type_t parse_unary(parser_state &state, size_t &node)
+    {
+        if (accept(state, "~"))
+        {
+            if (++state.nesting > MAX_NESTING)
+            {
+                return ret_type_t::ERROR_INVALID_VALUE;
+            }
+            size_t operand = 0;
+            ret_type_t code = parse_unary(state, operand);
+            node = add_node(state, node_kind::NEGATION, logical_operation::NEGATION, operand, operand, 0);
+            --state.nesting;
+            return code;
+        }
+        return parse_primary(state, node);
+    }
+
+    static ret_type_t parse_primary(parser_state &state, size_t &node)
+    {
+        if (accept(state, "("))
+        {
+            ret_type_t code = parse_equivalence(state, node);
+            if (code == ret_type_t::SUCCESS && !accept(state, ")"))
+            {
+                code = ret_type_t::ERROR_INVALID_VALUE;
+            }
+            return code;
+        }
+        if (accept(state, "0") || accept(state, "1"))
+        {
+            node = add_node(state, node_kind::CONSTANT, logical_operation::NEGATION, 0, 0,
+                            state.text[state.position - 1] == '1');
+            return ret_type_t::SUCCESS;
+        }
+
+        size_t start = state.position;
+        while (state.position < state.text.size() &&
+               (isalnum(static_cast<unsigned char>(state.text[state.position])) || state.text[state.position] == '_'))
+        {
+            ++state.position;
+        }
+        if (state.position == start || isdigit(static_cast<unsigned char>(state.text[start])))
+        {
+            return ret_type_t::ERROR_INVALID_VALUE;
+        }
+        string name = state.text.substr(start, state.position - start);
+
+        const pair<const char *, logical_operation> functions[] = {
+            {"implication", logical_operation::IMPLICATION},
+            {"coimplication", logical_operation::EQUALANT},
+            {"equalant", logical_operation::EQUALANT},
+            {"pearce", logical_operation::PEARCE},
+            {"sheffer", logical_operation::SHEFFER}};
+        for (const auto &[function, operation] : functions)
+        {
+            if (name == function && accept(state, "("))
+            {
+                size_t left = 0;
+                size_t right = 0;
+                ret_type_t code = parse_equivalence(state, left);
+                if (code == ret_type_t::SUCCESS && !accept(state, ","))
+                {
+                    code = ret_type_t::ERROR_INVALID_VALUE;
+                }
+                if (code == ret_type_t::SUCCESS)
+                {
+                    code = parse_equivalence(state, right);
+                }
+                if (code == ret_type_t::SUCCESS && !accept(state, ")"))
+                {
+                    code = ret_type_t::ERROR_INVALID_VALUE;
+                }
+                if (code == ret_type_t::SUCCESS)
+                {
+                    node = add_node(state, node_kind::BINARY, operation, left, right, 0);
+                }
+                return code;
+            }
+        }
+
+        auto found = find(state.variables.begin(), state.variables.end(), name);
+        uint32_t index = static_cast<uint32_t>(found - state.variables.begin());
+        if (found == state.variables.end())
+        {
+            state.variables.push_back(name);
+        }
+        node = add_node(state, node_kind::VARIABLE, logical_operation::NEGATION, 0, 0, index);
+        return ret_type_t::SUCCESS;
+    }
+
+    // Nodes are created in post-order, so emitting them front to back yields valid stack code.
+    // Returns the number of stack slots the program needs.
+    static size_t emit_tree(const vector<formula_node> &nodes, vector<formula_instruction> &out)
+    {
+        size_t depth = 0;
+        size_t deepest = 0;
+        for (const formula_node &node : nodes)
+        {
+            switch (node.kind)
+            {
+            case node_kind::CONSTANT:
+                out.push_back({push_constant, node.value});
+                ++depth;
+                break;
+            case node_kind::VARIABLE:
+                out.push_back({push_variable, node.value});
+                ++depth;
+                break;
+            case node_kind::NEGATION:
+                out.push_back({negate, 0});
+                break;
+            case node_kind::BINARY:
+                out.push_back({binary_handler(node.operation), 0});
+                --depth;
+                break;
+            }
+            deepest = max(deepest, depth);
+        }
+        return deepest;
+    }
+
+    // One truth-table word: the formula's value for the 64 assignments starting at 64 * chunk,
+    // evaluated in the same post-order as emit_tree.
+    // Children always precede their parent in nodes, so a single forward sweep evaluates the tree.
+    static uint64_t truth_word(const vector<formula_node> &nodes, const size_t chunk, vector<uint64_t> &values)
+    {
+        const uint64_t columns[6] = {0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL, 0xF0F0F0F0F0F0F0F0ULL,
+                                     0xFF00FF00FF00FF00ULL, 0xFFFF0000FFFF0000ULL, 0xFFFFFFFF00000000ULL};
+        for (size_t i = 0; i < nodes.size(); ++i)
+        {
+            const formula_node &node = nodes[i];
+            switch (node.kind)
+            {
+            case node_kind::CONSTANT:
+                values[i] = node.value ? ~uint64_t(0) : 0;
+                break;
+            case node_kind::VARIABLE:
+                values[i] = node.value < 6 ? columns[node.value] : (((chunk >> (node.value - 6)) & 1) ? ~uint64_t(0) : 0);
+                break;
+            case node_kind::NEGATION:
+                values[i] = ~values[node.left];
+                break;
+            case node_kind::BINARY:
+            {
+                uint64_t a = values[node.left];
+                uint64_t b = values[node.right];
+                switch (node.operation)
+                {
+                case logical_operation::CONJUNCTION:
+                    values[i] = a & b;
+                    break;
+                case logical_operation::DISJUNCTION:
+                    values[i] = a | b;
+                    break;
+                case logical_operation::EXCLUSIVE_OR:
+                    values[i] = a ^ b;
+                    break;
+                case logical_operation::IMPLICATION:
+                    values[i] = ~a | b;
+                    break;
+                case logical_operation::PEARCE:
+                    values[i] = ~(a | b);
+                    break;
+                case logical_operation::SHEFFER:
+                    values[i] = ~(a & b);
+                    break;
+                default:
+                    values[i] = ~(a ^ b);
+                    break;
+                }
+                break;
+            }
+            }
+        }
+        return values.back();
+    }
+
+    // Builds the truth table and turns it into algebraic normal form coefficients in place with the
+    // binary Moebius transform: bit m of the result is set when the conjunction of the variables in
+    // mask m appears in the xor.
+    static vector<uint64_t> anf_coefficients(const vector<formula_node> &nodes, const size_t variable_count)
+    {
+        size_t assignments = size_t(1) << variable_count;
+        vector<uint64_t> table((assignments + 63) / 64);
+        vector<uint64_t> values(nodes.size());
+        for (size_t chunk = 0; chunk < table.size(); ++chunk)
+        {
+            table[chunk] = truth_word(nodes, chunk, values);
+        }
+        if (assignments < 64)
+        {
+            table[0] &= (uint64_t(1) << assignments) - 1;
+        }
+
+        const uint64_t low_halves[6] = {0x5555555555555555ULL, 0x3333333333333333ULL, 0x0F0F0F0F0F0F0F0FULL,
+                                        0x00FF00FF00FF00FFULL, 0x0000FFFF0000FFFFULL, 0x00000000FFFFFFFFULL};
+        for (size_t variable = 0; variable < variable_count; ++variable)
+        {
+            if (variable < 6)
+            {
+                for (uint64_t &word : table)
+                {
+                    word ^= (word & low_halves[variable]) << (size_t(1) << variable);
+                }
+            }
+            else
+            {
+                size_t stride = size_t(1) << (variable - 6);
+                for (size_t chunk = 0; chunk < table.size(); ++chunk)
+                {
+                    if (chunk & stride)
+                    {
+                        table[chunk] ^= table[chunk ^ stride];
+                    }
+                }
+            }
+        }
+        return table;
+    }
+
+    static void emit_anf(const vector<uint64_t> &coefficients, vector<formula_instruction> &out)
+    {
+        bool first = true;
+        for (size_t chunk = 0; chunk < coefficients.size(); ++chunk)
+        {
+            for (uint64_t bits = coefficients[chunk]; bits != 0; bits &= bits - 1)
+            {
+                size_t mask = chunk * 64 + static_cast<size_t>(countr_zero(bits));
+                if (mask == 0)
+                {
+                    out.push_back({push_constant, 1});
+                }
+                else
+                {
+                    out.push_back({push_variable, static_cast<uint32_t>(countr_zero(mask))});
+                    for (size_t rest = mask & (mask - 1); rest != 0; rest &= rest - 1)
+                    {
+                        out.push_back({and_variable, static_cast<uint32_t>(countr_zero(rest))});
+                    }
+                }
+                if (!first)
+                {
+                    out.push_back({exclusive_or, 0});
+                }
+                first = false;
+            }
+        }
+        if (first)
+        {
+            out.push_back({push_constant, 0});
+        }
+    }
+
+public:
+    static ret_type_t compile(const string &source, logical_formula &formula)
+    {
+        vector<formula_node> nodes;
+        vector<string> names;
+        parser_state state{source, 0, 0, nodes, names};
+        size_t root = 0;
+        ret_type_t code = parse_equivalence(state, root);
+        skip_spaces(state);
+        if (code != ret_type_t::SUCCESS || state.position != source.size())
+        {
+            return ret_type_t::ERROR_INVALID_VALUE;
+        }
+
+        vector<formula_instruction> tree;
+        size_t depth = emit_tree(nodes, tree);
+        bool use_anf = false;
+        vector<formula_instruction> anf;
+        if (names.size() <= MAX_ANF_VARIABLES)
+        {
+            emit_anf(anf_coefficients(nodes, names.size()), anf);
+            use_anf = anf.size() <= tree.size();
+        }
+        if (!use_anf && depth > formula_machine::MAX_STACK_DEPTH)
+        {
+            return ret_type_t::ERROR_INVALID_VALUE;
+        }
+
+        formula.variables = move(names);
+        formula.program = use_anf ? move(anf) : move(tree);
+        formula.minimized = use_anf;
+        return ret_type_t::SUCCESS;
+    }
+
+    size_t variable_count() const
+    {
+        return variables.size();
+    }
+
+    const string &variable_name(const size_t index) const
+    {
+        return variables[index];
+    }
+
+    ret_type_t variable_index(const string &name, size_t &index) const
+    {
+        auto found = find(variables.begin(), variables.end(), name);
+        if (found == variables.end())
+        {
+            return ret_type_t::ERROR_INVALID_VALUE;
+        }
+        index = static_cast<size_t>(found - variables.begin());
+        return ret_type_t::SUCCESS;
+    }
+
+    size_t instruction_count() const
+    {
+        return program.size();
+    }
+
+    bool is_minimized() const
+    {
+        return minimized;
+    }
+
+    // inputs[i] is the value of variable_name(i); every bit lane is an independent evaluation.
+    ret_type_t evaluate(const logical_values_array *inputs, const size_t count, logical_values_array &result) const
+    {
+        if (count != variables.size() || (inputs == nullptr && count != 0) || program.empty())
+        {
+            return ret_type_t::ERROR_INVALID_VALUE;
+        }
+        formula_machine machine;
+        machine.top = 0;
+        machine.inputs = inputs;
+        for (const formula_instruction &instruction : program)
+        {
+            instruction.handler(machine, instruction.operand);
+        }
+        result.set_value(machine.stack[0]);
+        return ret_type_t::SUCCESS;
+    }
+};
+
+ret_type_t legacy_to_binary_string(const unsigned int value, char *destiny)
+{
+    if (destiny == nullptr)
+    {
+        return ret_type_t::ERROR_INVALID_VALUE;
+    }
+    unsigned int number = value;
+    vector<char> buffer;
+
+    if (number == 0)
+    {
+        buffer.push_back('0');
+    }
+    else
+    {
+        while (number > 0)
+        {
+            buffer.push_back((number & 1) ? '1' : '0');
+            number >>= 1;
+        }
+        reverse(buffer.begin(), buffer.end());
+    }
+
+    if (buffer.size() + 1 > numeric_limits<ptrdiff_t>::max())
+    {
+        return ret_type_t::ERROR_MALLOC;
+    }
+
+    for (size_t i = 0; i < buffer.size(); ++i)
+    {
+        destiny[i] = buffer[i];
+    }
+    destiny[buffer.size()] = '\0';
+
+    return ret_type_t::SUCCESS;
+}
+
+ret_type_t run_format_benchmark()
+{
+    const size_t count = 1 << 20;
+    vector<logical_values_array> values(count);
+    uint32_t seed = 2463534242u;
+    for (size_t i = 0; i < count; ++i)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        values[i].set_value(seed >> (i % 32));
+    }
+
+    char text[logical_values_array::max_binary_digits + 1];
+    size_t checksum_legacy = 0;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i)
+    {
+        ret_type_t code = legacy_to_binary_string(values[i].get_value(), text);
+        if (code != ret_type_t::SUCCESS)
+        {
+            return code;
+        }
+        checksum_legacy += strlen(text) + static_cast<size_t>(text[0]);
+    }
+    double legacy = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    size_t checksum = 0;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i)
+    {
+        ret_type_t code = values[i].to_binary_string(text);
+        if (code != ret_type_t::SUCCESS)
+        {
+            return code;
+        }
+        checksum += strlen(text) + static_cast<size_t>(text[0]);
+    }
+    double table = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    vector<char> joined(count * (logical_values_array::max_binary_digits + 1) + 1);
+    start = chrono::steady_clock::now();
+    binary_chars_result result = logical_values_array::to_binary_strings(values.data(), count, '\n', joined.data(),
+                                                                         joined.data() + joined.size());
+    double bulk = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    if (result.code != ret_type_t::SUCCESS)
+    {
+        return result.code;
+    }
+    if (checksum != checksum_legacy)
+    {
+        return ret_type_t::ERROR_INVALID_VALUE;
+    }
+
+    cout << fixed << setprecision(1);
+    cout << "to_binary_string over " << count << " values: legacy " << count / legacy / 1e6 << " M/s, table "
+         << count / table / 1e6 << " M/s, bulk " << count / bulk / 1e6 << " M/s ("
+         << static_cast<size_t>(result.ptr - joined.data()) << " chars)" << endl;
+    return ret_type_t::SUCCESS;
+}
+
+ret_type_t run_formula_benchmark()
+{
+    const char *source = "sheffer(a -> b, c) ^ pearce(a, d) | (b <-> d) & ~c";
+    logical_formula formula;
+    ret_type_t code = logical_formula::compile(source, formula);
+    if (code != ret_type_t::SUCCESS)
+    {
+        return code;
+    }
+
+    const size_t iterations = 10000000;
+    logical_values_array inputs[4] = {logical_values_array(0x12345678u), logical_values_array(0x9ABCDEF0u),
+                                      logical_values_array(0x0F1E2D3Cu), logical_values_array(0xC3A59687u)};
+    unsigned int checksum_direct = 0;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        inputs[i % 4].set_value(inputs[i % 4].get_value() + 0x9E3779B9u);
+        const logical_values_array &a = inputs[0];
+        const logical_values_array &b = inputs[1];
+        const logical_values_array &c = inputs[2];
+        const logical_values_array &d = inputs[3];
+        checksum_direct ^= ((a.implication(b).sheffer(c) ^ a.pearce(d)) | (b.equalant(d) & ~c)).get_value();
+    }
+    double direct = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    inputs[0].set_value(0x12345678u);
+    inputs[1].set_value(0x9ABCDEF0u);
+    inputs[2].set_value(0x0F1E2D3Cu);
+    inputs[3].set_value(0xC3A59687u);
+    unsigned int checksum = 0;
+    logical_values_array result;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        inputs[i % 4].set_value(inputs[i % 4].get_value() + 0x9E3779B9u);
+        code = formula.evaluate(inputs, 4, result);
+        if (code != ret_type_t::SUCCESS)
+        {
+            return code;
+        }
+        checksum ^= result.get_value();
+    }
+    double compiled = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    if (checksum != checksum_direct)
+    {
+        return ret_type_t::ERROR_INVALID_VALUE;
+    }
+
+    cout << "Formula \"" << source << "\" -> " << formula.instruction_count() << " instructions"
+         << (formula.is_minimized() ? " (algebraic normal form)" : "") << endl;
+    cout << "  hand-composed: " << iterations * 32 / direct / 1e6 << " M rule evaluations/s" << endl;
+    cout << "  compiled:      " << iterations * 32 / compiled / 1e6 << " M rule evaluations/s" << endl;
+    return ret_type_t::SUCCESS;
+}
+
+ret_type_t run_benchmark()
+{
+    const size_t bits = size_t(1) << 27;
+    const int repeats = 20;
+
+    logical_values_vector a(bits);
+    logical_values_vector b(bits);
+    logical_values_vector result(bits);
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < bits; i += 7)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        if (a.set_bit(i, seed & 1) != ret_type_t::SUCCESS || b.set_bit(i, (seed >> 1) & 1) != ret_type_t::SUCCESS)
+        {
+            return ret_type_t::ERROR_INVALID_VALUE;
+        }
+    }
+
+    const pair<const char *, logical_operation> operations[] = {
+        {"and", logical_operation::CONJUNCTION},
+        {"or", logical_operation::DISJUNCTION},
+        {"xor", logical_operation::EXCLUSIVE_OR},
+        {"implication", logical_operation::IMPLICATION},
+        {"equalant", logical_operation::EQUALANT},
+        {"pearce", logical_operation::PEARCE},
+        {"sheffer", logical_operation::SHEFFER},
+        {"not", logical_operation::NEGATION}};
+
+    const double bytes = static_cast<double>(bits / 8);
+    cout << "Bitset kernels over " << bits << " bits";
+#if defined(__AVX2__)
+    cout << " (AVX2)" << endl;
+#else
+    cout << " (scalar)" << endl;
+#endif
+    cout << fixed << setprecision(2);
+    for (const auto &[name, operation] : operations)
+    {
+        auto start = chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r)
+        {
+            ret_type_t code = logical_values_vector::evaluate(operation, a, b, result);
+            if (code != ret_type_t::SUCCESS)
+            {
+                return code;
+            }
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        double streams = operation == logical_operation::NEGATION ? 2.0 : 3.0;
+        cout << setw(12) << name << ": " << setw(8) << bytes * streams * repeats / seconds / 1e9 << " GB/s" << endl;
+    }
+
+    logical_values_vector c = a ^ b.sheffer(a);
+    logical_values_vector step1(bits);
+    logical_values_vector step2(bits);
+    logical_values_vector step3(bits);
+    auto stepwise_start = chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r)
+    {
+        ret_type_t code = logical_values_vector::evaluate(logical_operation::IMPLICATION, a, b, step1);
+        if (code == ret_type_t::SUCCESS)
+        {
+            code = logical_values_vector::evaluate(logical_operation::SHEFFER, step1, c, step2);
+        }
+        if (code == ret_type_t::SUCCESS)
+        {
+            code = logical_values_vector::evaluate(logical_operation::NEGATION, a, a, step3);
+        }
+        if (code == ret_type_t::SUCCESS)
+        {
+            code = logical_values_vector::evaluate(logical_operation::EXCLUSIVE_OR, step2, step3, result);
+        }
+        if (code != ret_type_t::SUCCESS)
+        {
+            return code;
+        }
+    }
+    double stepwise = chrono::duration<double>(chrono::steady_clock::now() - stepwise_start).count();
+    size_t stepwise_ones = result.count();
+
+    auto fused_start = chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r)
+    {
+        ret_type_t code = result.assign(a.implication(b).sheffer(c) ^ ~a);
+        if (code != ret_type_t::SUCCESS)
+        {
+            return code;
+        }
+    }
+    double fused = chrono::duration<double>(chrono::steady_clock::now() - fused_start).count();
+    if (result.count() != stepwise_ones)
+    {
+        return ret_type_t::ERROR_INVALID_VALUE;
+    }
+    cout << "((a -> b) sheffer c) ^ ~a: stepwise " << stepwise * 1e3 / repeats << " ms, fused "
+         << fused * 1e3 / repeats << " ms (" << stepwise / fused << "x)" << endl;
+
+    size_t ones = 0;
+    bool any_set = false;
+    bool all_set = true;
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r)
+    {
+        ones += a.count();
+        any_set = any_set || a.any();
+        all_set = all_set && a.all();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << setw(12) << "scan" << ": " << setw(8) << bytes * 3 * repeats / seconds / 1e9 << " GB/s"
+         << " (count " << ones / repeats << ", any " << any_set << ", all " << all_set << ")" << endl;
+
+    ret_type_t code = run_format_benchmark();
+    if (code != ret_type_t::SUCCESS)
+    {
+        return code;
+    }
+    return run_formula_benchmark();
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 2 || (argc == 2 && strcmp(argv[1], "--bench") != 0))
+    {
+        logError(ret_type_t::ERROR_ARGUMENTS);
+        cerr << "Usage: " << argv[0] << " [--bench]" << endl;
+        return static_cast<int>(ret_type_t::ERROR_ARGUMENTS);
+    }
+
+    if (argc == 2)
+    {
+        ret_type_t code;
+        try
+        {
+            code = run_benchmark();
+        }
+        catch (const bad_alloc &)
+        {
+            code = ret_type_t::ERROR_MALLOC;
+        }
+        if (code != ret_type_t::SUCCESS)
+        {
+            logError(code);
+        }
+        return static_cast<int>(code);
+    }
+
+    logical_values_array a(5);
+    logical_values_array b(3);
+
+    cout << "a: " << a.get_value() << endl;
+    cout << "b: " << b.get_value() << endl;
+
+    cout << "a & b: " << (a & b).get_value() << endl;
+    cout << "a | b: " << (a | b).get_value() << endl;
+    cout << "a ^ b: " << (a ^ b).get_value() << endl;
+    cout << "~a: " << (~a).get_value() << endl;
+    cout << "a -> b: " << a.implication(b).get_value() << endl;
+    cout << "a <-> b: " << a.coimplication(b).get_value() << endl;
+    cout << "a == b: " << a.equalant(b).get_value() << endl;
+    cout << "a ↓ b: " << a.pearce(b).get_value() << endl;
+    cout << "a | b: " << a.sheffer(b).get_value() << endl;
+
+    cout << "Bit 0 of a: " << a.get_bit(0) << endl;
+    cout << "Bit 1 of a: " << a.get_bit(1) << endl;
+    cout << "Bit 2 of a: " << a.get_bit(2) << endl;
+
+    cout << "Bit 0 of b: " << b.get_bit(0) << endl;
+    cout << "Bit 1 of b: " << b.get_bit(1) << endl;
+
+    char binary_str[logical_values_array::max_binary_digits + 1];
+    ret_type_t code = a.to_binary_string(binary_str);
+    if (code != ret_type_t::SUCCESS)
+    {
+        logError(code);
+        return static_cast<int>(code);
+    }
+    cout << "Binary representation of a: " << binary_str << endl;
+
+    const logical_values_array values[] = {a, b, a ^ b, logical_values_array(0)};
+    char joined[sizeof(values) / sizeof(values[0]) * (logical_values_array::max_binary_digits + 1) + 1];
+    binary_chars_result joined_result = logical_values_array::to_binary_strings(
+        values, sizeof(values) / sizeof(values[0]), ' ', joined, joined + sizeof(joined));
+    if (joined_result.code != ret_type_t::SUCCESS)
+    {
+        logError(joined_result.code);
+        return static_cast<int>(joined_result.code);
+    }
+    cout << "Binary representation of a, b, a ^ b, 0: " << joined << endl;
+
+    logical_formula formula;
+    code = logical_formula::compile("a -> b & ~(a ^ b) | pearce(a, 0)", formula);
+    if (code != ret_type_t::SUCCESS)
+    {
+        logError(code);
+        return static_cast<int>(code);
+    }
+    logical_values_array formula_inputs[] = {a, b};
+    logical_values_array formula_result;
+    code = formula.evaluate(formula_inputs, 2, formula_result);
+    if (code != ret_type_t::SUCCESS)
+    {
+        logError(code);
+        return static_cast<int>(code);
+    }
+    cout << "a -> b & ~(a ^ b) | pearce(a, 0): " << formula_result.get_value() << " (" << formula.instruction_count()
+         << " instructions)" << endl;
+
+    logical_values_array c(5);
+    cout << "a == c: " << logical_values_array::equals(a, c) << endl;
+    cout << "a == b: " << logical_values_array::equals(a, b) << endl;
+
+    try
+    {
+        logical_values_vector x(200);
+        logical_values_vector y(200, true);
+        for (size_t i = 0; i < x.size(); i += 3)
+        {
+            x.set_bit(i, true);
+        }
+        cout << "Vector of " << x.size() << " bits, ones in x: " << x.count() << endl;
+        logical_values_vector implied = x.implication(y);
+        logical_values_vector negated = ~x;
+        logical_values_vector contradiction = x & ~x;
+        cout << "Ones in x -> y: " << implied.count() << ", all: " << implied.all() << endl;
+        cout << "Ones in ~x: " << negated.count() << ", any in x & ~x: " << contradiction.any() << endl;
+        logical_values_vector fused = x.implication(y).sheffer(~x) ^ y;
+        cout << "Ones in ((x -> y) sheffer ~x) ^ y: " << fused.count() << endl;
+    }
+    catch (const bad_alloc &)
+    {
+        logError(ret_type_t::ERROR_MALLOC);
+        return static_cast<int>(ret_type_t::ERROR_MALLOC);
+    }
 
     return static_cast<int>(ret_type_t::SUCCESS);
 }
\ No newline at end of file
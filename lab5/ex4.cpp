@@ -3,6 +3,21 @@
 #include <limits>
 #include <stdexcept>
 #include <iomanip>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+#include <bit>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 class Complex
 {
@@ -43,15 +58,26 @@ public:
                        real * other.imag + imag * other.real);
     }
 
+    // Smith's algorithm: both parts are divided through by the larger component of other, so no
+    // intermediate squares a magnitude and results stay finite across the whole double range. The
+    // near-zero test compares |other|^2 = pivot^2 (1 + r^2) with epsilon; a zero divisor makes r NaN
+    // and fails it as well.
     Complex divide(const Complex &other, double epsilon = std::numeric_limits<double>::epsilon()) const
     {
-        double denominator = other.real * other.real + other.imag * other.imag;
-        if (std::abs(denominator) < epsilon)
+        bool swapped = std::abs(other.imag) > std::abs(other.real);
+        double pivot = swapped ? other.imag : other.real;
+        double rest = swapped ? other.real : other.imag;
+        double r = rest / pivot;
+        if (!(pivot * pivot * (1.0 + r * r) >= epsilon))
         {
             throw std::runtime_error("Division by zero or near-zero value");
         }
-        return Complex((real * other.real + imag * other.imag) / denominator,
-                       (imag * other.real - real * other.imag) / denominator);
+
+        double first = swapped ? imag : real;
+        double second = swapped ? real : imag;
+        double scale = 1.0 / (pivot + rest * r);
+        double sign = swapped ? -1.0 : 1.0;
+        return Complex((first + second * r) * scale, sign * (second - first * r) * scale);
     }
 
     double magnitude() const
@@ -86,6 +112,932 @@ std::ostream &operator<<(std::ostream &os, const Complex &c)
     return os;
 }
 
+struct scalar_double_lanes
+{
+    using vector = double;
+    using mask = bool;
+    static constexpr std::size_t width = 1;
+
+    static vector load(const double *source) { return *source; }
+    static void store(double *destination, vector value) { *destination = value; }
+    static vector broadcast(double value) { return value; }
+    static vector add(vector a, vector b) { return a + b; }
+    static vector subtract(vector a, vector b) { return a - b; }
+    static vector multiply(vector a, vector b) { return a * b; }
+    static vector divide(vector a, vector b) { return a / b; }
+    static vector square_root(vector a) { return std::sqrt(a); }
+    static vector absolute(vector a) { return std::fabs(a); }
+    static vector minimum(vector a, vector b) { return a < b ? a : b; }
+    static vector maximum(vector a, vector b) { return a > b ? a : b; }
+    static vector copy_sign(vector magnitude, vector sign) { return std::copysign(magnitude, sign); }
+    static mask less(vector a, vector b) { return a < b; }
+    static mask not_at_least(vector a, vector b) { return !(a >= b); }
+    static mask mask_and(mask a, mask b) { return a && b; }
+    static mask mask_or(mask a, mask b) { return a || b; }
+    static bool any(mask m) { return m; }
+    static int bits(mask m) { return m ? 1 : 0; }
+    static vector select(mask m, vector a, vector b) { return m ? a : b; }
+};
+
+#if defined(__AVX__)
+struct simd_double_lanes
+{
+    using vector = __m256d;
+    using mask = __m256d;
+    static constexpr std::size_t width = 4;
+
+    static vector load(const double *source) { return _mm256_loadu_pd(source); }
+    static void store(double *destination, vector value) { _mm256_storeu_pd(destination, value); }
+    static vector broadcast(double value) { return _mm256_set1_pd(value); }
+    static vector add(vector a, vector b) { return _mm256_add_pd(a, b); }
+    static vector subtract(vector a, vector b) { return _mm256_sub_pd(a, b); }
+    static vector multiply(vector a, vector b) { return _mm256_mul_pd(a, b); }
+    static vector divide(vector a, vector b) { return _mm256_div_pd(a, b); }
+    static vector square_root(vector a) { return _mm256_sqrt_pd(a); }
+    static vector absolute(vector a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    static vector minimum(vector a, vector b) { return _mm256_min_pd(a, b); }
+    static vector maximum(vector a, vector b) { return _mm256_max_pd(a, b); }
+    static vector copy_sign(vector magnitude, vector sign)
+    {
+        return _mm256_or_pd(absolute(magnitude), _mm256_and_pd(_mm256_set1_pd(-0.0), sign));
+    }
+    static mask less(vector a, vector b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static mask not_at_least(vector a, vector b) { return _mm256_cmp_pd(a, b, _CMP_NGE_UQ); }
+    static mask mask_and(mask a, mask b) { return _mm256_and_pd(a, b); }
+    static mask mask_or(mask a, mask b) { return _mm256_or_pd(a, b); }
+    static bool any(mask m) { return _mm256_movemask_pd(m) != 0; }
+    static int bits(mask m) { return _mm256_movemask_pd(m); }
+    static vector select(mask m, vector a, vector b) { return _mm256_blendv_pd(b, a, m); }
+};
+#elif defined(__SSE2__)
+struct simd_double_lanes
+{
+    using vector = __m128d;
+    using mask = __m128d;
+    static constexpr std::size_t width = 2;
+
+    static vector load(const double *source) { return _mm_loadu_pd(source); }
+    static void store(double *destination, vector value) { _mm_storeu_pd(destination, value); }
+    static vector broadcast(double value) { return _mm_set1_pd(value); }
+    static vector add(vector a, vector b) { return _mm_add_pd(a, b); }
+    static vector subtract(vector a, vector b) { return _mm_sub_pd(a, b); }
+    static vector multiply(vector a, vector b) { return _mm_mul_pd(a, b); }
+    static vector divide(vector a, vector b) { return _mm_div_pd(a, b); }
+    static vector square_root(vector a) { return _mm_sqrt_pd(a); }
+    static vector absolute(vector a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    static vector minimum(vector a, vector b) { return _mm_min_pd(a, b); }
+    static vector maximum(vector a, vector b) { return _mm_max_pd(a, b); }
+    static vector copy_sign(vector magnitude, vector sign)
+    {
+        return _mm_or_pd(absolute(magnitude), _mm_and_pd(_mm_set1_pd(-0.0), sign));
+    }
+    static mask less(vector a, vector b) { return _mm_cmplt_pd(a, b); }
+    static mask not_at_least(vector a, vector b) { return _mm_cmpnge_pd(a, b); }
+    static mask mask_and(mask a, mask b) { return _mm_and_pd(a, b); }
+    static mask mask_or(mask a, mask b) { return _mm_or_pd(a, b); }
+    static bool any(mask m) { return _mm_movemask_pd(m) != 0; }
+    static int bits(mask m) { return _mm_movemask_pd(m); }
+    static vector select(mask m, vector a, vector b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+};
+#else
+using simd_double_lanes = scalar_double_lanes;
+#endif
+
+enum class DivideStatus : std::uint8_t
+{
+    SUCCESS = 0,
+    NEAR_ZERO_DIVISOR = 1
+};
+
+// Structure-of-arrays batch of complex numbers: real and imaginary parts live in separate arrays so
+// every kernel works on whole SIMD registers of one component. Results follow the scalar Complex
+// formulas and may alias either operand.
+class ComplexBuffer
+{
+private:
+    std::vector<double> realParts;
+    std::vector<double> imagParts;
+
+    void requireSameSize(const ComplexBuffer &other) const
+    {
+        if (other.size() != size())
+        {
+            throw std::invalid_argument("Complex buffers must have the same size");
+        }
+    }
+
+    template <typename Lanes>
+    static void addRange(const double *ar, const double *ai, const double *br, const double *bi,
+                         double *rr, double *ri, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; i += Lanes::width)
+        {
+            Lanes::store(rr + i, Lanes::add(Lanes::load(ar + i), Lanes::load(br + i)));
+            Lanes::store(ri + i, Lanes::add(Lanes::load(ai + i), Lanes::load(bi + i)));
+        }
+    }
+
+    template <typename Lanes>
+    static void subtractRange(const double *ar, const double *ai, const double *br, const double *bi,
+                              double *rr, double *ri, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; i += Lanes::width)
+        {
+            Lanes::store(rr + i, Lanes::subtract(Lanes::load(ar + i), Lanes::load(br + i)));
+            Lanes::store(ri + i, Lanes::subtract(Lanes::load(ai + i), Lanes::load(bi + i)));
+        }
+    }
+
+    template <typename Lanes>
+    static void multiplyRange(const double *ar, const double *ai, const double *br, const double *bi,
+                              double *rr, double *ri, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; i += Lanes::width)
+        {
+            typename Lanes::vector xr = Lanes::load(ar + i);
+            typename Lanes::vector xi = Lanes::load(ai + i);
+            typename Lanes::vector yr = Lanes::load(br + i);
+            typename Lanes::vector yi = Lanes::load(bi + i);
+            Lanes::store(rr + i, Lanes::subtract(Lanes::multiply(xr, yr), Lanes::multiply(xi, yi)));
+            Lanes::store(ri + i, Lanes::add(Lanes::multiply(xr, yi), Lanes::multiply(xi, yr)));
+        }
+    }
+
+    // Smith's division, lane for lane as in Complex::divide. Lanes whose divisor is near zero get
+    // NaN and, when status is given, NEAR_ZERO_DIVISOR. Returns how many lanes failed.
+    template <typename Lanes>
+    static std::size_t divideRange(const double *ar, const double *ai, const double *br, const double *bi,
+                                   double *rr, double *ri, DivideStatus *status, std::size_t begin, std::size_t end,
+                                   double epsilon)
+    {
+        using vector = typename Lanes::vector;
+        const vector one = Lanes::broadcast(1.0);
+        const vector limit = Lanes::broadcast(epsilon);
+        const vector invalid = Lanes::broadcast(std::numeric_limits<double>::quiet_NaN());
+        std::size_t failures = 0;
+        for (std::size_t i = begin; i < end; i += Lanes::width)
+        {
+            vector xr = Lanes::load(ar + i);
+            vector xi = Lanes::load(ai + i);
+            vector yr = Lanes::load(br + i);
+            vector yi = Lanes::load(bi + i);
+            typename Lanes::mask swapped = Lanes::less(Lanes::absolute(yr), Lanes::absolute(yi));
+            vector pivot = Lanes::select(swapped, yi, yr);
+            vector rest = Lanes::select(swapped, yr, yi);
+            vector r = Lanes::divide(rest, pivot);
+            vector magnitudeSquared = Lanes::multiply(Lanes::multiply(pivot, pivot), Lanes::add(one, Lanes::multiply(r, r)));
+            typename Lanes::mask bad = Lanes::not_at_least(magnitudeSquared, limit);
+
+            vector first = Lanes::select(swapped, xi, xr);
+            vector second = Lanes::select(swapped, xr, xi);
+            vector scale = Lanes::divide(one, Lanes::add(pivot, Lanes::multiply(rest, r)));
+            vector quotientReal = Lanes::multiply(Lanes::add(first, Lanes::multiply(second, r)), scale);
+            vector quotientImag = Lanes::multiply(Lanes::subtract(second, Lanes::multiply(first, r)), scale);
+            quotientImag = Lanes::select(swapped, Lanes::subtract(Lanes::broadcast(0.0), quotientImag), quotientImag);
+
+            Lanes::store(rr + i, Lanes::select(bad, invalid, quotientReal));
+            Lanes::store(ri + i, Lanes::select(bad, invalid, quotientImag));
+            int badBits = Lanes::bits(bad);
+            failures += static_cast<std::size_t>(std::popcount(static_cast<unsigned int>(badBits)));
+            if (status != nullptr)
+            {
+                for (std::size_t lane = 0; lane < Lanes::width; ++lane)
+                {
+                    status[i + lane] = ((badBits >> lane) & 1) ? DivideStatus::NEAR_ZERO_DIVISOR : DivideStatus::SUCCESS;
+                }
+            }
+        }
+        return failures;
+    }
+
+    template <typename Lanes>
+    static void magnitudeRange(const double *ar, const double *ai, double *out, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; i += Lanes::width)
+        {
+            typename Lanes::vector xr = Lanes::load(ar + i);
+            typename Lanes::vector xi = Lanes::load(ai + i);
+            Lanes::store(out + i, Lanes::square_root(Lanes::add(Lanes::multiply(xr, xr), Lanes::multiply(xi, xi))));
+        }
+    }
+
+    // atan2 built from the Cephes rational approximation of atan on [0, 1]: the smaller component
+    // is divided by the larger, reduced around pi/4 above 0.66, and the quadrant is restored from
+    // the component signs. Agrees with std::atan2 to a few ulp.
+    template <typename Lanes>
+    static void argumentRange(const double *ar, const double *ai, double *out, std::size_t begin, std::size_t end,
+                              double epsilon)
+    {
+        using vector = typename Lanes::vector;
+        const vector zero = Lanes::broadcast(0.0);
+        const vector one = Lanes::broadcast(1.0);
+        const vector limit = Lanes::broadcast(epsilon);
+        const vector pi = Lanes::broadcast(3.14159265358979323846);
+        const vector halfPi = Lanes::broadcast(1.57079632679489661923);
+        const vector quarterPi = Lanes::broadcast(0.78539816339744830962);
+        const vector moreBits = Lanes::broadcast(6.123233995736765886130E-17);
+        const double p[] = {-8.750608600031904122785E-1, -1.615753718733365076637E1, -7.500855792314704667340E1,
+                            -1.228866684490136173410E2, -6.485021904942025371773E1};
+        const double q[] = {2.485846490142306297962E1, 1.650270098316988542046E2, 4.328810604912902668951E2,
+                            4.853903996359136964868E2, 1.945506571482613964425E2};
+
+        for (std::size_t i = begin; i < end; i += Lanes::width)
+        {
+            vector x = Lanes::load(ar + i);
+            vector y = Lanes::load(ai + i);
+            vector ax = Lanes::absolute(x);
+            vector ay = Lanes::absolute(y);
+            vector high = Lanes::maximum(ax, ay);
+            vector low = Lanes::minimum(ax, ay);
+            typename Lanes::mask degenerate = Lanes::mask_and(Lanes::less(ax, limit), Lanes::less(ay, limit));
+            vector t = Lanes::divide(low, Lanes::select(degenerate, one, high));
+
+            typename Lanes::mask upper = Lanes::less(Lanes::broadcast(0.66), t);
+            t = Lanes::select(upper, Lanes::divide(Lanes::subtract(t, one), Lanes::add(t, one)), t);
+            vector z = Lanes::multiply(t, t);
+            vector numerator = Lanes::broadcast(p[0]);
+            for (std::size_t k = 1; k < 5; ++k)
+            {
+                numerator = Lanes::add(Lanes::multiply(numerator, z), Lanes::broadcast(p[k]));
+            }
+            vector denominator = Lanes::add(z, Lanes::broadcast(q[0]));
+            for (std::size_t k = 1; k < 5; ++k)
+            {
+                denominator = Lanes::add(Lanes::multiply(denominator, z), Lanes::broadcast(q[k]));
+            }
+            vector angle = Lanes::add(t, Lanes::multiply(t, Lanes::divide(Lanes::multiply(z, numerator), denominator)));
+            angle = Lanes::add(Lanes::select(upper, quarterPi, zero),
+                               Lanes::add(angle, Lanes::select(upper, Lanes::multiply(moreBits, Lanes::broadcast(0.5)), zero)));
+
+            angle = Lanes::select(Lanes::less(ax, ay), Lanes::add(Lanes::subtract(halfPi, angle), moreBits), angle);
+            angle = Lanes::select(Lanes::less(x, zero),
+                                  Lanes::add(Lanes::subtract(pi, angle), Lanes::add(moreBits, moreBits)), angle);
+            angle = Lanes::copy_sign(angle, y);
+            Lanes::store(out + i, Lanes::select(degenerate, zero, angle));
+        }
+    }
+
+    template <typename Kernel>
+    void binaryOperation(const ComplexBuffer &other, ComplexBuffer &result, Kernel simdKernel, Kernel scalarKernel) const
+    {
+        requireSameSize(other);
+        result.resize(size());
+        std::size_t vectorEnd = size() - size() % simd_double_lanes::width;
+        simdKernel(realParts.data(), imagParts.data(), other.realParts.data(), other.imagParts.data(),
+                   result.realParts.data(), result.imagParts.data(), 0, vectorEnd);
+        scalarKernel(realParts.data(), imagParts.data(), other.realParts.data(), other.imagParts.data(),
+                     result.realParts.data(), result.imagParts.data(), vectorEnd, size());
+    }
+
+public:
+    explicit ComplexBuffer(std::size_t size = 0) : realParts(size), imagParts(size) {}
+
+    std::size_t size() const { return realParts.size(); }
+
+    void resize(std::size_t size)
+    {
+        realParts.resize(size);
+        imagParts.resize(size);
+    }
+
+    void set(std::size_t index, const Complex &value)
+    {
+        if (index >= size())
+        {
+            throw std::out_of_range("Complex buffer index out of range");
+        }
+        realParts[index] = value.getReal();
+        imagParts[index] = value.getImag();
+    }
+
+    Complex get(std::size_t index) const
+    {
+        if (index >= size())
+        {
+            throw std::out_of_range("Complex buffer index out of range");
+        }
+        return Complex(realParts[index], imagParts[index]);
+    }
+
+    double *realData() { return realParts.data(); }
+    double *imagData() { return imagParts.data(); }
+    const double *realData() const { return realParts.data(); }
+    const double *imagData() const { return imagParts.data(); }
+
+    void add(const ComplexBuffer &other, ComplexBuffer &result) const
+    {
+        binaryOperation(other, result, addRange<simd_double_lanes>, addRange<scalar_double_lanes>);
+    }
+
+    void subtract(const ComplexBuffer &other, ComplexBuffer &result) const
+    {
+        binaryOperation(other, result, subtractRange<simd_double_lanes>, subtractRange<scalar_double_lanes>);
+    }
+
+    void multiply(const ComplexBuffer &other, ComplexBuffer &result) const
+    {
+        binaryOperation(other, result, multiplyRange<simd_double_lanes>, multiplyRange<scalar_double_lanes>);
+    }
+
+    std::size_t divideInto(const ComplexBuffer &other, ComplexBuffer &result, DivideStatus *status,
+                           double epsilon) const
+    {
+        requireSameSize(other);
+        result.resize(size());
+        std::size_t vectorEnd = size() - size() % simd_double_lanes::width;
+        std::size_t failures = divideRange<simd_double_lanes>(realParts.data(), imagParts.data(), other.realParts.data(),
+                                                              other.imagParts.data(), result.realParts.data(),
+                                                              result.imagParts.data(), status, 0, vectorEnd, epsilon);
+        failures += divideRange<scalar_double_lanes>(realParts.data(), imagParts.data(), other.realParts.data(),
+                                                     other.imagParts.data(), result.realParts.data(),
+                                                     result.imagParts.data(), status, vectorEnd, size(), epsilon);
+        return failures;
+    }
+
+    // Like Complex::divide, throws when a divisor is near zero; the other samples are still divided.
+    void divide(const ComplexBuffer &other, ComplexBuffer &result,
+                double epsilon = std::numeric_limits<double>::epsilon()) const
+    {
+        if (divideInto(other, result, nullptr, epsilon) != 0)
+        {
+            throw std::runtime_error("Division by zero or near-zero value");
+        }
+    }
+
+    // Non-throwing division for batch runs: a near-zero divisor only marks its own sample (NaN
+    // result, NEAR_ZERO_DIVISOR status). Returns the number of such samples.
+    std::size_t tryDivide(const ComplexBuffer &other, ComplexBuffer &result, std::vector<DivideStatus> &status,
+                          double epsilon = std::numeric_limits<double>::epsilon()) const
+    {
+        requireSameSize(other);
+        status.resize(size());
+        return divideInto(other, result, status.data(), epsilon);
+    }
+
+    void magnitude(std::vector<double> &result) const
+    {
+        result.resize(size());
+        std::size_t vectorEnd = size() - size() % simd_double_lanes::width;
+        magnitudeRange<simd_double_lanes>(realParts.data(), imagParts.data(), result.data(), 0, vectorEnd);
+        magnitudeRange<scalar_double_lanes>(realParts.data(), imagParts.data(), result.data(), vectorEnd, size());
+    }
+
+    void argument(std::vector<double> &result, double epsilon = std::numeric_limits<double>::epsilon()) const
+    {
+        result.resize(size());
+        std::size_t vectorEnd = size() - size() % simd_double_lanes::width;
+        argumentRange<simd_double_lanes>(realParts.data(), imagParts.data(), result.data(), 0, vectorEnd, epsilon);
+        argumentRange<scalar_double_lanes>(realParts.data(), imagParts.data(), result.data(), vectorEnd, size(), epsilon);
+    }
+};
+
+// Mixed-radix FFT over Complex. The size is factored into radix-4 stages first, then 2, 3 and any
+// remaining primes, and the transform recurses as a decimation in time: each level runs p
+// sub-transforms of size m on strided input, then combines them with radix-p butterflies that
+// read one shared table of size() twiddles. forward computes X[k] = sum x[j] e^(-2 pi i jk / n);
+// inverse uses the conjugate twiddles and divides by n, so inverse(forward(x)) == x.
+class FftPlan
+{
+private:
+    static constexpr std::size_t PARALLEL_THRESHOLD = 1 << 14;
+
+    std::size_t n;
+    std::vector<std::size_t> factors;
+    std::vector<Complex> forwardTwiddles;
+    std::vector<Complex> inverseTwiddles;
+
+    static Complex scale(const Complex &value, double factor)
+    {
+        return Complex(value.getReal() * factor, value.getImag() * factor);
+    }
+
+    // Multiplication by -i (forward) or +i (inverse).
+    static Complex rotate(const Complex &value, bool inverse)
+    {
+        return inverse ? Complex(-value.getImag(), value.getReal()) : Complex(value.getImag(), -value.getReal());
+    }
+
+    static void butterfly2(Complex *out, std::size_t stride, std::size_t m, const Complex *twiddles)
+    {
+        for (std::size_t k = 0; k < m; ++k)
+        {
+            Complex t = out[k + m].multiply(twiddles[k * stride]);
+            out[k + m] = out[k].subtract(t);
+            out[k] = out[k].add(t);
+        }
+    }
+
+    static void butterfly3(Complex *out, std::size_t stride, std::size_t m, const Complex *twiddles, bool inverse)
+    {
+        const double sine = inverse ? 0.86602540378443864676 : -0.86602540378443864676;
+        for (std::size_t k = 0; k < m; ++k)
+        {
+            Complex s1 = out[k + m].multiply(twiddles[k * stride]);
+            Complex s2 = out[k + 2 * m].multiply(twiddles[2 * k * stride]);
+            Complex sum = s1.add(s2);
+            Complex difference = scale(s1.subtract(s2), sine);
+            Complex middle = out[k].subtract(scale(sum, 0.5));
+            out[k] = out[k].add(sum);
+            out[k + m] = Complex(middle.getReal() - difference.getImag(), middle.getImag() + difference.getReal());
+            out[k + 2 * m] = Complex(middle.getReal() + difference.getImag(), middle.getImag() - difference.getReal());
+        }
+    }
+
+    static void butterfly4(Complex *out, std::size_t stride, std::size_t m, const Complex *twiddles, bool inverse)
+    {
+        for (std::size_t k = 0; k < m; ++k)
+        {
+            Complex s0 = out[k + m].multiply(twiddles[k * stride]);
+            Complex s1 = out[k + 2 * m].multiply(twiddles[2 * k * stride]);
+            Complex s2 = out[k + 3 * m].multiply(twiddles[3 * k * stride]);
+            Complex evenSum = out[k].add(s1);
+            Complex evenDifference = out[k].subtract(s1);
+            Complex oddSum = s0.add(s2);
+            Complex oddDifference = rotate(s0.subtract(s2), inverse);
+            out[k] = evenSum.add(oddSum);
+            out[k + m] = evenDifference.add(oddDifference);
+            out[k + 2 * m] = evenSum.subtract(oddSum);
+            out[k + 3 * m] = evenDifference.subtract(oddDifference);
+        }
+    }
+
+    void butterflyGeneric(Complex *out, std::size_t stride, std::size_t m, std::size_t p, const Complex *twiddles) const
+    {
+        std::vector<Complex> scratch(p);
+        for (std::size_t u = 0; u < m; ++u)
+        {
+            for (std::size_t q = 0; q < p; ++q)
+            {
+                scratch[q] = out[u + q * m];
+            }
+            for (std::size_t q = 0; q < p; ++q)
+            {
+                std::size_t k = u + q * m;
+                std::size_t index = 0;
+                Complex sum = scratch[0];
+                for (std::size_t r = 1; r < p; ++r)
+                {
+                    index += stride * k;
+                    if (index >= n)
+                    {
+                        index -= n;
+                    }
+                    sum = sum.add(scratch[r].multiply(twiddles[index]));
+                }
+                out[k] = sum;
+            }
+        }
+    }
+
+    void work(Complex *out, const Complex *in, std::size_t stride, const std::size_t *factor, const Complex *twiddles,
+              bool inverse, std::size_t threads) const
+    {
+        std::size_t p = factor[0];
+        std::size_t m = factor[1];
+        if (m == 1)
+        {
+            for (std::size_t j = 0; j < p; ++j)
+            {
+                out[j] = in[j * stride];
+            }
+        }
+        else if (threads > 1 && p * m >= PARALLEL_THRESHOLD)
+        {
+            // Sub-transforms are independent; worker t takes every threads-th one.
+            std::size_t workers = std::min(threads, p);
+            std::size_t nested = std::max<std::size_t>(1, threads / p);
+            auto runShare = [&](std::size_t first)
+            {
+                for (std::size_t j = first; j < p; j += workers)
+                {
+                    work(out + j * m, in + j * stride, stride * p, factor + 2, twiddles, inverse, nested);
+                }
+            };
+            std::vector<std::future<void>> pending;
+            for (std::size_t t = 1; t < workers; ++t)
+            {
+                pending.push_back(std::async(std::launch::async, runShare, t));
+            }
+            runShare(0);
+            for (std::future<void> &task : pending)
+            {
+                task.get();
+            }
+        }
+        else
+        {
+            for (std::size_t j = 0; j < p; ++j)
+            {
+                work(out + j * m, in + j * stride, stride * p, factor + 2, twiddles, inverse, 1);
+            }
+        }
+
+        switch (p)
+        {
+        case 1:
+            break;
+        case 2:
+            butterfly2(out, stride, m, twiddles);
+            break;
+        case 3:
+            butterfly3(out, stride, m, twiddles, inverse);
+            break;
+        case 4:
+            butterfly4(out, stride, m, twiddles, inverse);
+            break;
+        default:
+            butterflyGeneric(out, stride, m, p, twiddles);
+            break;
+        }
+    }
+
+public:
+    explicit FftPlan(std::size_t size) : n(size)
+    {
+        if (size == 0)
+        {
+            throw std::invalid_argument("FFT size must be positive");
+        }
+        std::size_t remaining = size;
+        std::size_t radix = 4;
+        do
+        {
+            while (remaining % radix != 0)
+            {
+                radix = radix == 4 ? 2 : (radix == 2 ? 3 : radix + 2);
+                if (radix * radix > remaining)
+                {
+                    radix = remaining;
+                }
+            }
+            remaining /= radix;
+            factors.push_back(radix);
+            factors.push_back(remaining);
+        } while (remaining > 1);
+
+        forwardTwiddles.reserve(size);
+        inverseTwiddles.reserve(size);
+        for (std::size_t k = 0; k < size; ++k)
+        {
+            double angle = -2.0 * 3.14159265358979323846 * static_cast<double>(k) / static_cast<double>(size);
+            forwardTwiddles.emplace_back(std::cos(angle), std::sin(angle));
+            inverseTwiddles.emplace_back(std::cos(angle), -std::sin(angle));
+        }
+    }
+
+    // Plans are immutable, so one instance per size is shared by every caller.
+    static std::shared_ptr<const FftPlan> forSize(std::size_t size)
+    {
+        static std::mutex guard;
+        static std::map<std::size_t, std::shared_ptr<const FftPlan>> plans;
+        std::lock_guard<std::mutex> lock(guard);
+        std::shared_ptr<const FftPlan> &plan = plans[size];
+        if (!plan)
+        {
+            plan = std::make_shared<const FftPlan>(size);
+        }
+        return plan;
+    }
+
+    std::size_t size() const { return n; }
+
+    const std::vector<std::size_t> &radices() const { return factors; }
+
+    // Out-of-place transform of n values; input and output must not overlap.
+    void transform(const Complex *input, Complex *output, bool inverse = false, std::size_t threads = 1) const
+    {
+        if (input == nullptr || output == nullptr)
+        {
+            throw std::invalid_argument("FFT buffers must not be null");
+        }
+        if (input == output)
+        {
+            throw std::invalid_argument("Out-of-place FFT needs distinct buffers");
+        }
+        work(output, input, 1, factors.data(), inverse ? inverseTwiddles.data() : forwardTwiddles.data(), inverse,
+             std::max<std::size_t>(1, threads));
+        if (inverse)
+        {
+            double factor = 1.0 / static_cast<double>(n);
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                output[k] = scale(output[k], factor);
+            }
+        }
+    }
+
+    void transform(std::vector<Complex> &data, bool inverse = false, std::size_t threads = 1) const
+    {
+        if (data.size() != n)
+        {
+            throw std::invalid_argument("FFT input size does not match the plan");
+        }
+        std::vector<Complex> result(n);
+        transform(data.data(), result.data(), inverse, threads);
+        data.swap(result);
+    }
+};
+
+// Forward transform of n real samples into the n / 2 + 1 non-redundant bins. For even n the samples
+// are packed pairwise into a complex transform of half the size, then split using the identity
+// X[k] = E[k] + e^(-2 pi i k / n) O[k], with E and O recovered from Z[k] and conj(Z[n/2 - k]).
+class RealFftPlan
+{
+private:
+    std::size_t n;
+    std::shared_ptr<const FftPlan> plan;
+    std::vector<Complex> splitTwiddles;
+
+public:
+    explicit RealFftPlan(std::size_t size)
+        : n(size), plan(FftPlan::forSize(size % 2 == 0 ? size / 2 : size))
+    {
+        if (size % 2 == 0)
+        {
+            for (std::size_t k = 0; k <= size / 2; ++k)
+            {
+                double angle = -2.0 * 3.14159265358979323846 * static_cast<double>(k) / static_cast<double>(size);
+                splitTwiddles.emplace_back(std::cos(angle), std::sin(angle));
+            }
+        }
+    }
+
+    static std::shared_ptr<const RealFftPlan> forSize(std::size_t size)
+    {
+        static std::mutex guard;
+        static std::map<std::size_t, std::shared_ptr<const RealFftPlan>> plans;
+        std::lock_guard<std::mutex> lock(guard);
+        std::shared_ptr<const RealFftPlan> &cached = plans[size];
+        if (!cached)
+        {
+            cached = std::make_shared<const RealFftPlan>(size);
+        }
+        return cached;
+    }
+
+    std::size_t size() const { return n; }
+
+    void transform(const std::vector<double> &input, std::vector<Complex> &output, std::size_t threads = 1) const
+    {
+        if (input.size() != n)
+        {
+            throw std::invalid_argument("FFT input size does not match the plan");
+        }
+        output.resize(n / 2 + 1);
+        if (n % 2 != 0)
+        {
+            std::vector<Complex> samples(n);
+            std::vector<Complex> spectrum(n);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                samples[i] = Complex(input[i], 0.0);
+            }
+            plan->transform(samples.data(), spectrum.data(), false, threads);
+            std::copy(spectrum.begin(), spectrum.begin() + static_cast<std::ptrdiff_t>(output.size()), output.begin());
+            return;
+        }
+
+        std::size_t half = n / 2;
+        std::vector<Complex> packed(half);
+        std::vector<Complex> spectrum(half);
+        for (std::size_t i = 0; i < half; ++i)
+        {
+            packed[i] = Complex(input[2 * i], input[2 * i + 1]);
+        }
+        plan->transform(packed.data(), spectrum.data(), false, threads);
+        for (std::size_t k = 0; k <= half; ++k)
+        {
+            const Complex &z = spectrum[k % half];
+            const Complex &mirror = spectrum[(half - k) % half];
+            Complex even((z.getReal() + mirror.getReal()) * 0.5, (z.getImag() - mirror.getImag()) * 0.5);
+            Complex odd((z.getImag() + mirror.getImag()) * 0.5, (mirror.getReal() - z.getReal()) * 0.5);
+            output[k] = even.add(splitTwiddles[k].multiply(odd));
+        }
+    }
+};
+
+// Direct O(n^2) evaluation of the same sum as FftPlan::transform, used as the reference.
+void naiveDft(const std::vector<Complex> &input, std::vector<Complex> &output, bool inverse = false)
+{
+    std::size_t n = input.size();
+    std::vector<Complex> twiddles(n);
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        double angle = (inverse ? 2.0 : -2.0) * 3.14159265358979323846 * static_cast<double>(k) / static_cast<double>(n);
+        twiddles[k] = Complex(std::cos(angle), std::sin(angle));
+    }
+    output.assign(n, Complex());
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        Complex sum;
+        std::size_t index = 0;
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            sum = sum.add(input[j].multiply(twiddles[index]));
+            index += k;
+            if (index >= n)
+            {
+                index -= n;
+            }
+        }
+        output[k] = inverse ? Complex(sum.getReal() / n, sum.getImag() / n) : sum;
+    }
+}
+
+// Polynomial with complex coefficients; coefficients[i] multiplies z^i, the same layout that
+// calculate_polynomial uses in lab2, and every evaluation is Horner's scheme over that array.
+class ComplexPolynomial
+{
+private:
+    static constexpr std::size_t PARALLEL_DEGREE = 128;
+
+    std::vector<Complex> coefficients;
+
+    template <typename Lanes>
+    void evaluateRange(const double *zr, const double *zi, double *vr, double *vi, std::size_t begin,
+                       std::size_t end) const
+    {
+        using vector = typename Lanes::vector;
+        for (std::size_t i = begin; i < end; i += Lanes::width)
+        {
+            vector xr = Lanes::load(zr + i);
+            vector xi = Lanes::load(zi + i);
+            vector sumReal = Lanes::broadcast(coefficients.back().getReal());
+            vector sumImag = Lanes::broadcast(coefficients.back().getImag());
+            for (std::size_t k = coefficients.size() - 1; k-- > 0;)
+            {
+                vector nextReal = Lanes::add(Lanes::subtract(Lanes::multiply(sumReal, xr), Lanes::multiply(sumImag, xi)),
+                                             Lanes::broadcast(coefficients[k].getReal()));
+                sumImag = Lanes::add(Lanes::add(Lanes::multiply(sumReal, xi), Lanes::multiply(sumImag, xr)),
+                                     Lanes::broadcast(coefficients[k].getImag()));
+                sumReal = nextReal;
+            }
+            Lanes::store(vr + i, sumReal);
+            Lanes::store(vi + i, sumImag);
+        }
+    }
+
+    // Horner on |a_i| and |z|: the scale of the rounding error in evaluate(z).
+    double errorBound(double radius) const
+    {
+        double bound = 0.0;
+        for (std::size_t k = coefficients.size(); k-- > 0;)
+        {
+            bound = bound * radius + coefficients[k].magnitude();
+        }
+        return bound;
+    }
+
+    // One Aberth-Ehrlich step for roots [begin, end), reading only current so slices can run in parallel.
+    void aberthStep(const std::vector<Complex> &current, std::vector<Complex> &next, std::vector<char> &converged,
+                    std::size_t begin, std::size_t end, double tolerance) const
+    {
+        const double roundoff = 4.0 * std::numeric_limits<double>::epsilon();
+        for (std::size_t k = begin; k < end; ++k)
+        {
+            next[k] = current[k];
+            if (converged[k])
+            {
+                continue;
+            }
+            Complex value;
+            Complex derivative;
+            evaluateWithDerivative(current[k], value, derivative);
+            double radius = current[k].magnitude();
+            if (value.magnitude() <= roundoff * errorBound(radius))
+            {
+                converged[k] = 1;
+                continue;
+            }
+            if (derivative.magnitude() == 0.0)
+            {
+                next[k] = current[k].add(Complex(tolerance * std::max(1.0, radius), tolerance));
+                continue;
+            }
+
+            Complex newton = value.divide(derivative, 0.0);
+            Complex repulsion;
+            for (std::size_t j = 0; j < current.size(); ++j)
+            {
+                Complex gap = current[k].subtract(current[j]);
+                if (j != k && gap.magnitude() > 0.0)
+                {
+                    repulsion = repulsion.add(Complex(1.0, 0.0).divide(gap, 0.0));
+                }
+            }
+            Complex denominator = Complex(1.0, 0.0).subtract(newton.multiply(repulsion));
+            Complex offset = denominator.magnitude() > 0.0 ? newton.divide(denominator, 0.0) : newton;
+            next[k] = current[k].subtract(offset);
+            if (offset.magnitude() <= tolerance * std::max(1.0, radius))
+            {
+                converged[k] = 1;
+            }
+        }
+    }
+
+public:
+    explicit ComplexPolynomial(std::vector<Complex> values) : coefficients(std::move(values))
+    {
+        while (!coefficients.empty() && coefficients.back().magnitude() == 0.0)
+        {
+            coefficients.pop_back();
+        }
+        if (coefficients.empty())
+        {
+            throw std::invalid_argument("Polynomial must have a non-zero coefficient");
+        }
+    }
+
+    std::size_t degree() const { return coefficients.size() - 1; }
+
+    const Complex &coefficient(std::size_t index) const { return coefficients.at(index); }
+
+    Complex evaluate(const Complex &z) const
+    {
+        Complex result;
+        for (std::size_t k = coefficients.size(); k-- > 0;)
+        {
+            result = result.multiply(z).add(coefficients[k]);
+        }
+        return result;
+    }
+
+    void evaluateWithDerivative(const Complex &z, Complex &value, Complex &derivative) const
+    {
+        value = coefficients.back();
+        derivative = Complex();
+        for (std::size_t k = coefficients.size() - 1; k-- > 0;)
+        {
+            derivative = derivative.multiply(z).add(value);
+            value = value.multiply(z).add(coefficients[k]);
+        }
+    }
+
+    // Batched Horner over a ComplexBuffer of points, one SIMD register of points per step.
+    void evaluate(const ComplexBuffer &points, ComplexBuffer &values) const
+    {
+        values.resize(points.size());
+        std::size_t vectorEnd = points.size() - points.size() % simd_double_lanes::width;
+        evaluateRange<simd_double_lanes>(points.realData(), points.imagData(), values.realData(), values.imagData(), 0,
+                                         vectorEnd);
+        evaluateRange<scalar_double_lanes>(points.realData(), points.imagData(), values.realData(), values.imagData(),
+                                           vectorEnd, points.size());
+    }
+
+    // All degree() roots by simultaneous Aberth-Ehrlich iteration, started on a circle of radius
+    // |a_0 / a_n|^(1/n). A root stops moving once its correction is below tolerance relative to its
+    // size, or |p(z)| is within rounding error. Every step reads only the previous iterate, so with
+    // threads > 1 and a large degree the roots are split between workers with identical results.
+    std::vector<Complex> roots(double tolerance = 1e-12, std::size_t maxIterations = 1000, std::size_t threads = 1) const
+    {
+        std::size_t n = degree();
+        std::vector<Complex> current(n);
+        if (n == 0)
+        {
+            return current;
+        }
+        double ratio = coefficients.front().magnitude() / coefficients.back().magnitude();
+        double radius = ratio > 0.0 ? std::pow(ratio, 1.0 / static_cast<double>(n)) : 1.0;
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            double angle = 2.0 * 3.14159265358979323846 * static_cast<double>(k) / static_cast<double>(n) + 0.4;
+            current[k] = Complex(radius * std::cos(angle), radius * std::sin(angle));
+        }
+
+        std::vector<Complex> next(n);
+        std::vector<char> converged(n, 0);
+        std::size_t workers = (threads > 1 && n >= PARALLEL_DEGREE) ? std::min(threads, n) : 1;
+        for (std::size_t iteration = 0; iteration < maxIterations; ++iteration)
+        {
+            if (workers == 1)
+            {
+                aberthStep(current, next, converged, 0, n, tolerance);
+            }
+            else
+            {
+                std::vector<std::future<void>> pending;
+                for (std::size_t t = 1; t < workers; ++t)
+                {
+                    pending.push_back(std::async(std::launch::async, [&, t]
+                                                 { aberthStep(current, next, converged, n * t / workers,
+                                                              n * (t + 1) / workers, tolerance); }));
+                }
+                aberthStep(current, next, converged, 0, n / workers, tolerance);
+                for (std::future<void> &task : pending)
+                {
+                    task.get();
+                }
+            }
+            current.swap(next);
+            if (std::all_of(converged.begin(), converged.end(), [](char done) { return done != 0; }))
+            {
+                return current;
+            }
+        }
+        throw std::runtime_error("Root finder did not converge");
+    }
+};
+
 int demonstrateComplexOperations()
 {
     Complex c1(2.0, 3.0);
@@ -108,18 +1060,467 @@ int demonstrateComplexOperations()
         return 1;
     }
 
+    try
+    {
+        Complex huge(1e300, 1e300);
+        std::cout << "(1e300+1e300i) / (2e300+2e300i) = " << huge.divide(Complex(2e300, 2e300)) << std::endl;
+    }
+    catch (const std::runtime_error &e)
+    {
+        std::cerr << "Error during division: " << e.what() << std::endl;
+        return 1;
+    }
+
     std::cout << "|c1| = " << c1.magnitude() << std::endl;
     std::cout << "arg(c1) = " << c1.argument() << " radians" << std::endl;
 
     return 0;
 }
 
-int main()
+double relativeError(double actual, double expected)
+{
+    return std::abs(actual - expected) / std::max(1.0, std::abs(expected));
+}
+
+void fillSamples(ComplexBuffer &buffer, unsigned int seed)
+{
+    for (std::size_t i = 0; i < buffer.size(); ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        double angle = (seed >> 8) * (6.283185307179586 / 16777216.0);
+        double radius = std::ldexp(1.0 + (seed & 0xFF) / 256.0, static_cast<int>(seed % 17) - 8);
+        buffer.set(i, Complex(radius * std::cos(angle), radius * std::sin(angle)));
+    }
+}
+
+int demonstrateBatchOperations()
+{
+    const std::size_t count = 1003;
+    ComplexBuffer a(count);
+    ComplexBuffer b(count);
+    fillSamples(a, 12345u);
+    fillSamples(b, 67890u);
+    a.set(0, Complex(0.0, 0.0));
+    a.set(1, Complex(-1.0, -0.0));
+    a.set(2, Complex(-3.0, 0.0));
+    a.set(3, Complex(0.0, -2.0));
+
+    ComplexBuffer sum;
+    ComplexBuffer difference;
+    ComplexBuffer product;
+    ComplexBuffer quotient;
+    std::vector<double> magnitudes;
+    std::vector<double> arguments;
+    try
+    {
+        a.add(b, sum);
+        a.subtract(b, difference);
+        a.multiply(b, product);
+        a.divide(b, quotient);
+        a.magnitude(magnitudes);
+        a.argument(arguments);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error during batch operation: " << e.what() << std::endl;
+        return 1;
+    }
+
+    double worst = 0.0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Complex x = a.get(i);
+        Complex y = b.get(i);
+        const std::pair<Complex, Complex> pairs[] = {{sum.get(i), x.add(y)},
+                                                     {difference.get(i), x.subtract(y)},
+                                                     {product.get(i), x.multiply(y)},
+                                                     {quotient.get(i), x.divide(y)}};
+        for (const auto &[actual, expected] : pairs)
+        {
+            worst = std::max(worst, relativeError(actual.getReal(), expected.getReal()));
+            worst = std::max(worst, relativeError(actual.getImag(), expected.getImag()));
+        }
+        worst = std::max(worst, relativeError(magnitudes[i], x.magnitude()));
+        worst = std::max(worst, relativeError(arguments[i], x.argument()));
+    }
+
+    ComplexBuffer divisors(b);
+    divisors.set(5, Complex(0.0, 0.0));
+    std::vector<DivideStatus> status;
+    std::size_t failures = a.tryDivide(divisors, quotient, status);
+    if (failures != 1 || status[5] != DivideStatus::NEAR_ZERO_DIVISOR || status[6] != DivideStatus::SUCCESS)
+    {
+        std::cerr << "Error: batch division did not isolate the zero divisor" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Batch kernels on " << count << " samples, max relative error vs Complex: "
+              << std::scientific << std::setprecision(2) << worst << std::fixed << std::endl;
+    if (worst > 1e-13)
+    {
+        std::cerr << "Error: batch kernels disagree with scalar Complex" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int runBenchmark()
+{
+    const std::size_t count = 1 << 16;
+    const int repeats = 500;
+    ComplexBuffer a(count);
+    ComplexBuffer b(count);
+    fillSamples(a, 1u);
+    fillSamples(b, 2u);
+    std::vector<Complex> scalarA(count);
+    std::vector<Complex> scalarB(count);
+    std::vector<Complex> scalarResult(count);
+    std::vector<double> scalarReal(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        scalarA[i] = a.get(i);
+        scalarB[i] = b.get(i);
+    }
+    ComplexBuffer result(count);
+    std::vector<double> real(count);
+
+    auto measure = [&](const char *name, auto &&batch, auto &&scalar)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r)
+        {
+            batch();
+        }
+        double batchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                scalar(i);
+            }
+        }
+        double scalarSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << std::setw(10) << name << ": batch " << std::setw(8) << count * repeats / batchSeconds / 1e6
+                  << " M samples/s, scalar " << std::setw(8) << count * repeats / scalarSeconds / 1e6
+                  << " M samples/s" << std::endl;
+    };
+
+    std::cout << "Complex kernels over " << count << " samples (" << simd_double_lanes::width << " lanes)" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    try
+    {
+        measure("add", [&] { a.add(b, result); }, [&](std::size_t i) { scalarResult[i] = scalarA[i].add(scalarB[i]); });
+        measure("subtract", [&] { a.subtract(b, result); },
+                [&](std::size_t i) { scalarResult[i] = scalarA[i].subtract(scalarB[i]); });
+        measure("multiply", [&] { a.multiply(b, result); },
+                [&](std::size_t i) { scalarResult[i] = scalarA[i].multiply(scalarB[i]); });
+        measure("divide", [&] { a.divide(b, result); },
+                [&](std::size_t i) { scalarResult[i] = scalarA[i].divide(scalarB[i]); });
+        std::vector<DivideStatus> status;
+        measure("tryDivide", [&] { a.tryDivide(b, result, status); },
+                [&](std::size_t i) { scalarResult[i] = scalarA[i].divide(scalarB[i]); });
+        measure("magnitude", [&] { a.magnitude(real); }, [&](std::size_t i) { scalarReal[i] = scalarA[i].magnitude(); });
+        measure("argument", [&] { a.argument(real); }, [&](std::size_t i) { scalarReal[i] = scalarA[i].argument(); });
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error during benchmark: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int demonstrateFft()
+{
+    const std::size_t n = 12;
+    std::vector<Complex> signal(n);
+    std::vector<double> realSignal(n);
+    for (std::size_t j = 0; j < n; ++j)
+    {
+        realSignal[j] = std::cos(2.0 * 3.14159265358979323846 * 3.0 * static_cast<double>(j) / n) + 0.5;
+        signal[j] = Complex(realSignal[j], 0.0);
+    }
+
+    std::vector<Complex> spectrum(n);
+    std::vector<Complex> realSpectrum;
+    std::vector<Complex> reference;
+    try
+    {
+        FftPlan::forSize(n)->transform(signal.data(), spectrum.data());
+        RealFftPlan::forSize(n)->transform(realSignal, realSpectrum);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error during FFT: " << e.what() << std::endl;
+        return 1;
+    }
+    naiveDft(signal, reference);
+
+    std::cout << "FFT of 0.5 + cos(2*pi*3j/12), |X[k]|:";
+    double worst = 0.0;
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        std::cout << " " << spectrum[k].magnitude();
+        worst = std::max(worst, spectrum[k].subtract(reference[k]).magnitude());
+        if (k < realSpectrum.size())
+        {
+            worst = std::max(worst, realSpectrum[k].subtract(reference[k]).magnitude());
+        }
+    }
+    std::cout << std::endl;
+    if (worst > 1e-12)
+    {
+        std::cerr << "Error: FFT disagrees with the direct DFT" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int runFftBenchmark()
+{
+    std::cout << "FFT against direct DFT" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    unsigned int seed = 7u;
+    auto randomSignal = [&seed](std::size_t n)
+    {
+        std::vector<Complex> signal(n);
+        for (Complex &value : signal)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            double re = static_cast<double>(seed >> 8) / 16777216.0 - 0.5;
+            seed = seed * 1664525u + 1013904223u;
+            value = Complex(re, static_cast<double>(seed >> 8) / 16777216.0 - 0.5);
+        }
+        return signal;
+    };
+
+    try
+    {
+        for (std::size_t n : {std::size_t(1000), std::size_t(1024), std::size_t(4096), std::size_t(4374)})
+        {
+            std::vector<Complex> signal = randomSignal(n);
+            std::vector<Complex> spectrum(n);
+            std::vector<Complex> reference;
+            std::shared_ptr<const FftPlan> plan = FftPlan::forSize(n);
+            const int repeats = 200;
+            auto start = std::chrono::steady_clock::now();
+            for (int r = 0; r < repeats; ++r)
+            {
+                plan->transform(signal.data(), spectrum.data());
+            }
+            double fast = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / repeats;
+            start = std::chrono::steady_clock::now();
+            naiveDft(signal, reference);
+            double naive = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            double worst = 0.0;
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                worst = std::max(worst, spectrum[k].subtract(reference[k]).magnitude());
+            }
+            std::cout << "  n = " << std::setw(5) << n << " (radices";
+            for (std::size_t i = 0; i < plan->radices().size(); i += 2)
+            {
+                std::cout << " " << plan->radices()[i];
+            }
+            std::cout << "): fft " << fast * 1e3 << " ms, dft " << naive * 1e3 << " ms, "
+                      << std::setprecision(1) << naive / fast << "x, max error " << std::scientific << worst
+                      << std::fixed << std::setprecision(3) << std::endl;
+        }
+
+        const std::size_t realSize = 1 << 16;
+        std::vector<double> samples(realSize);
+        for (std::size_t i = 0; i < realSize; ++i)
+        {
+            samples[i] = std::sin(0.001 * static_cast<double>(i * i % 7919));
+        }
+        std::vector<Complex> complexSamples(realSize);
+        for (std::size_t i = 0; i < realSize; ++i)
+        {
+            complexSamples[i] = Complex(samples[i], 0.0);
+        }
+        std::vector<Complex> bins;
+        std::vector<Complex> spectrum(realSize);
+        const int repeats = 50;
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r)
+        {
+            RealFftPlan::forSize(realSize)->transform(samples, bins);
+        }
+        double real = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / repeats;
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r)
+        {
+            FftPlan::forSize(realSize)->transform(complexSamples.data(), spectrum.data());
+        }
+        double full = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / repeats;
+        std::cout << "  real input, n = " << realSize << ": real path " << real * 1e3 << " ms, complex path "
+                  << full * 1e3 << " ms" << std::endl;
+
+        const std::size_t largeSize = 1 << 20;
+        std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<Complex> large = randomSignal(largeSize);
+        std::vector<Complex> largeSpectrum(largeSize);
+        std::shared_ptr<const FftPlan> plan = FftPlan::forSize(largeSize);
+        start = std::chrono::steady_clock::now();
+        plan->transform(large.data(), largeSpectrum.data(), false, 1);
+        double single = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        start = std::chrono::steady_clock::now();
+        plan->transform(large.data(), largeSpectrum.data(), false, threads);
+        double parallel = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "  n = " << largeSize << ": 1 thread " << single * 1e3 << " ms, " << threads << " threads "
+                  << parallel * 1e3 << " ms" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error during FFT benchmark: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int demonstratePolynomial()
+{
+    try
+    {
+        ComplexPolynomial cubic({Complex(-1.0, 0.0), Complex(0.0, 0.0), Complex(0.0, 0.0), Complex(1.0, 0.0)});
+        std::cout << "p(z) = z^3 - 1, p(2+1i) = " << cubic.evaluate(Complex(2.0, 1.0)) << std::endl;
+        std::vector<Complex> roots = cubic.roots();
+        std::cout << "Roots of z^3 - 1:";
+        for (const Complex &root : roots)
+        {
+            std::cout << " " << root;
+            if (cubic.evaluate(root).magnitude() > 1e-12)
+            {
+                std::cerr << "Error: root finder returned an inexact root" << std::endl;
+                return 1;
+            }
+        }
+        std::cout << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error in polynomial module: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int runPolynomialBenchmark()
 {
+    unsigned int seed = 99u;
+    auto randomComplex = [&seed]()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        double re = static_cast<double>(seed >> 8) / 8388608.0 - 1.0;
+        seed = seed * 1664525u + 1013904223u;
+        return Complex(re, static_cast<double>(seed >> 8) / 8388608.0 - 1.0);
+    };
+
+    try
+    {
+        std::vector<Complex> coefficients(17);
+        for (Complex &value : coefficients)
+        {
+            value = randomComplex();
+        }
+        ComplexPolynomial polynomial(coefficients);
+        const std::size_t count = 1 << 16;
+        const int repeats = 50;
+        ComplexBuffer points(count);
+        std::vector<Complex> scalarPoints(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            scalarPoints[i] = randomComplex();
+            points.set(i, scalarPoints[i]);
+        }
+        ComplexBuffer values;
+        std::vector<Complex> scalarValues(count);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r)
+        {
+            polynomial.evaluate(points, values);
+        }
+        double batch = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                scalarValues[i] = polynomial.evaluate(scalarPoints[i]);
+            }
+        }
+        double scalar = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Horner, degree " << polynomial.degree() << ": batch " << std::setprecision(1)
+                  << count * repeats / batch / 1e6 << " M points/s, scalar " << count * repeats / scalar / 1e6
+                  << " M points/s" << std::endl;
+
+        std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+        for (std::size_t degree : {std::size_t(50), std::size_t(400)})
+        {
+            std::vector<Complex> rootCoefficients(degree + 1);
+            for (Complex &value : rootCoefficients)
+            {
+                value = randomComplex();
+            }
+            ComplexPolynomial rootPolynomial(rootCoefficients);
+            start = std::chrono::steady_clock::now();
+            std::vector<Complex> serial = rootPolynomial.roots(1e-12, 1000, 1);
+            double serialSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            start = std::chrono::steady_clock::now();
+            std::vector<Complex> parallel = rootPolynomial.roots(1e-12, 1000, threads);
+            double parallelSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cout << "Aberth roots, degree " << degree << ": 1 thread " << std::setprecision(3)
+                      << serialSeconds * 1e3 << " ms, " << threads << " threads " << parallelSeconds * 1e3 << " ms"
+                      << std::endl;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error during polynomial benchmark: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 2 || (argc == 2 && std::strcmp(argv[1], "--bench") != 0))
+    {
+        std::cerr << "Usage: " << argv[0] << " [--bench]" << std::endl;
+        return 1;
+    }
+    if (argc == 2)
+    {
+        int result = runBenchmark();
+        if (result != 0)
+        {
+            return result;
+        }
+        result = runFftBenchmark();
+        if (result != 0)
+        {
+            return result;
+        }
+        return runPolynomialBenchmark();
+    }
+
     int result = demonstrateComplexOperations();
     if (result != 0)
     {
         return result;
     }
-    return 0;
-}
\ No newline at end of file
+    result = demonstrateBatchOperations();
+    if (result != 0)
+    {
+        return result;
+    }
+    result = demonstrateFft();
+    if (result != 0)
+    {
+        return result;
+    }
+    return demonstratePolynomial();
+}
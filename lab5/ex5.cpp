@@ -1,139 +1,825 @@
 #include <iostream>
 #include <fstream>
 #include <string>
-#include <regex>
+#include <string_view>
+#include <array>
 #include <algorithm>
+#include <set>
+#include <list>
+#include <mutex>
+#include <memory>
+#include <new>
+#include <cstdint>
+#include <unordered_map>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+#include <tuple>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
-bool isValidIdentifier(const std::string &identifier)
+bool isSpace(char c)
 {
-    std::regex identifierRegex("^[a-zA-Z_][a-zA-Z0-9_]*$");
-    return std::regex_match(identifier, identifierRegex);
+    return std::isspace(static_cast<unsigned char>(c)) != 0;
 }
 
-std::string cdecl_translate(const std::string &declaration)
+bool isIdentifierStart(char c)
 {
-    std::string input = declaration;
+    return std::isalpha(static_cast<unsigned char>(c)) != 0 || c == '_';
+}
 
-    std::replace(input.begin(), input.end(), ';', ' ');
-    input.erase(std::remove_if(input.begin(), input.end(), ::isspace), input.end());
+bool isIdentifierChar(char c)
+{
+    return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_';
+}
 
-    std::string description = "declare ";
-    std::string baseType;
-    std::string identifier;
-    std::string pointerPart;
-    std::string arrayPart;
-    std::string functionPart;
+bool isValidIdentifier(std::string_view identifier)
+{
+    if (identifier.empty() || !isIdentifierStart(identifier.front()))
+    {
+        return false;
+    }
+    for (char c : identifier)
+    {
+        if (!isIdentifierChar(c))
+        {
+            return false;
+        }
+    }
+    return true;
+}
 
-    std::smatch match;
-    std::regex baseTypeRegex("^(int|char|float|double|void)");
+enum class TokenKind
+{
+    IDENTIFIER,
+    NUMBER,
+    STAR,
+    LEFT_PAREN,
+    RIGHT_PAREN,
+    LEFT_BRACKET,
+    RIGHT_BRACKET,
+    SEMICOLON,
+    EQUALS,
+    END,
+    INVALID
+};
 
-    if (std::regex_search(input, match, baseTypeRegex))
+struct Token
+{
+    TokenKind kind = TokenKind::END;
+    std::string_view text;
+};
+
+// Hands out one token at a time as a view into the declaration, so lexing never copies or allocates.
+class DeclarationLexer
+{
+public:
+    explicit DeclarationLexer(std::string_view input) : input(input)
     {
-        baseType = match[0].str();
-        input = match.suffix().str();
+        current = scan(position);
     }
-    else
+
+    const Token &peek() const { return current; }
+
+    // The token after peek(), without consuming anything.
+    Token peekSecond() const
+    {
+        std::size_t offset = position;
+        return scan(offset);
+    }
+
+    Token next()
     {
-        return "Syntax error: Invalid base type.";
+        Token token = current;
+        current = scan(position);
+        return token;
     }
 
-    std::regex funcPtrRegex("^\\(\\*\\s*([a-zA-Z_][a-zA-Z0-9_]*)\\)\\((.*)\\)");
+    std::string_view source() const { return input; }
+
+    // Offset just past the token returned by peek().
+    std::size_t offset() const { return position; }
 
-    std::regex funcRegex("^\\(?([a-zA-Z_][a-zA-Z0-9_]*)\\)?\\((.*)\\)");
+    // Resumes lexing at an offset the caller has scanned past by hand.
+    void restartAt(std::size_t offset)
+    {
+        position = offset;
+        current = scan(position);
+    }
 
-    if (std::regex_search(input, match, funcPtrRegex))
+private:
+    Token scan(std::size_t &offset) const
     {
-        identifier = match[1].str();
-        if (!isValidIdentifier(identifier))
+        while (offset < input.size() && isSpace(input[offset]))
         {
-            return "Syntax error: invalid identifier.";
+            ++offset;
         }
-        std::string args = match[2].str();
-        description += identifier + " as pointer to function";
-        if (!args.empty() && args != "void")
+        if (offset == input.size())
         {
-            description += " accepting arguments: " + args;
+            return {TokenKind::END, input.substr(offset, 0)};
+        }
+
+        std::size_t start = offset;
+        char c = input[offset++];
+        if (isIdentifierStart(c) || std::isdigit(static_cast<unsigned char>(c)))
+        {
+            while (offset < input.size() && isIdentifierChar(input[offset]))
+            {
+                ++offset;
+            }
+            TokenKind kind = isIdentifierStart(c) ? TokenKind::IDENTIFIER : TokenKind::NUMBER;
+            return {kind, input.substr(start, offset - start)};
+        }
+
+        TokenKind kind = TokenKind::INVALID;
+        switch (c)
+        {
+        case '*':
+            kind = TokenKind::STAR;
+            break;
+        case '(':
+            kind = TokenKind::LEFT_PAREN;
+            break;
+        case ')':
+            kind = TokenKind::RIGHT_PAREN;
+            break;
+        case '[':
+            kind = TokenKind::LEFT_BRACKET;
+            break;
+        case ']':
+            kind = TokenKind::RIGHT_BRACKET;
+            break;
+        case ';':
+            kind = TokenKind::SEMICOLON;
+            break;
+        case '=':
+            kind = TokenKind::EQUALS;
+            break;
+        default:
+            break;
+        }
+        return {kind, input.substr(start, 1)};
+    }
+
+    std::string_view input;
+    std::size_t position = 0;
+    Token current;
+};
+
+enum class SpecifierKind
+{
+    NONE,
+    BASE_TYPE,
+    QUALIFIER,
+    STORAGE_CLASS,
+    TAG,
+    TYPEDEF
+};
+
+SpecifierKind classifySpecifier(std::string_view word)
+{
+    static constexpr std::string_view baseTypes[] = {"void", "char", "short", "int", "long", "float", "double",
+                                                     "signed", "unsigned", "bool", "_Bool", "_Complex"};
+    static constexpr std::string_view qualifiers[] = {"const", "volatile", "restrict"};
+    static constexpr std::string_view storageClasses[] = {"static", "extern", "register", "inline"};
+    static constexpr std::string_view tags[] = {"struct", "union", "enum"};
+
+    for (std::string_view keyword : baseTypes)
+    {
+        if (word == keyword)
+        {
+            return SpecifierKind::BASE_TYPE;
         }
-        description += " returning " + baseType;
-        return description;
     }
-    else if (std::regex_search(input, match, funcRegex))
+    for (std::string_view keyword : qualifiers)
     {
-        identifier = match[1].str();
-        if (!isValidIdentifier(identifier))
+        if (word == keyword)
         {
-            return "Syntax error: invalid identifier.";
+            return SpecifierKind::QUALIFIER;
         }
-        std::string args = match[2].str();
-        description += identifier + " as function";
-        if (!args.empty() && args != "void")
+    }
+    for (std::string_view keyword : storageClasses)
+    {
+        if (word == keyword)
         {
-            description += " accepting arguments: " + args;
+            return SpecifierKind::STORAGE_CLASS;
         }
-        description += " returning " + baseType;
-        return description;
     }
+    for (std::string_view keyword : tags)
+    {
+        if (word == keyword)
+        {
+            return SpecifierKind::TAG;
+        }
+    }
+    return word == "typedef" ? SpecifierKind::TYPEDEF : SpecifierKind::NONE;
+}
 
-    std::regex pointerRegex("^(\\*+)");
-    if (std::regex_search(input, match, pointerRegex))
+// Identifiers that name a type. The usual library typedefs are always known; a "typedef" line adds its
+// name, so later declarations in the same file can use it.
+class TypeNames
+{
+public:
+    bool contains(std::string_view name) const
     {
-        pointerPart = match[0].str();
-        input = match.suffix().str();
+        static constexpr std::string_view standardNames[] = {
+            "size_t",  "ptrdiff_t", "wchar_t", "int8_t",   "int16_t",   "int32_t", "int64_t",
+            "uint8_t", "uint16_t",  "uint32_t", "uint64_t", "intptr_t", "uintptr_t", "FILE"};
+        for (std::string_view standardName : standardNames)
+        {
+            if (name == standardName)
+            {
+                return true;
+            }
+        }
+        return declared.find(name) != declared.end();
     }
 
-    std::regex identifierRegex("^([a-zA-Z_][a-zA-Z0-9_]*)");
-    if (std::regex_search(input, match, identifierRegex))
+    void add(std::string_view name)
     {
-        identifier = match[0].str();
-        if (!isValidIdentifier(identifier))
+        if (declared.emplace(name).second)
         {
-            return "Syntax error: invalid identifier.";
+            // Order-independent, so two tables holding the same names always agree.
+            std::uint64_t hash = std::hash<std::string_view>()(name) * 0x9E3779B97F4A7C15ull;
+            namesFingerprint ^= hash ^ (hash >> 29);
         }
-        input = match.suffix().str();
     }
-    else
+
+    // Identifies the set of declared names; translations may differ only between different fingerprints.
+    std::uint64_t fingerprint() const { return namesFingerprint; }
+
+private:
+    std::set<std::string, std::less<>> declared;
+    std::uint64_t namesFingerprint = 0;
+};
+
+// Copies a parameter list while dropping whitespace, except for one space between two words.
+void appendCompacted(std::string &out, std::string_view text)
+{
+    char previous = '\0';
+    bool skippedSpace = false;
+    for (char c : text)
+    {
+        if (isSpace(c))
+        {
+            skippedSpace = true;
+            continue;
+        }
+        if (skippedSpace && isIdentifierChar(previous) && isIdentifierChar(c))
+        {
+            out += ' ';
+        }
+        out += c;
+        previous = c;
+        skippedSpace = false;
+    }
+}
+
+std::string_view trimmed(std::string_view text)
+{
+    while (!text.empty() && isSpace(text.front()))
+    {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && isSpace(text.back()))
+    {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+// Recursive-descent parser for "specifiers declarator [;]". The description is written while parsing,
+// following the spiral rule: the name first, then each nesting level's array and function suffixes from
+// left to right, then that level's pointers from right to left, and finally the specifiers.
+class DeclarationParser
+{
+public:
+    DeclarationParser(std::string_view declaration, TypeNames &typeNames, std::string &out)
+        : lexer(declaration), typeNames(typeNames), out(out), start(out.size())
+    {
+    }
+
+    // Appends the description to out, or the syntax error if the declaration is rejected. Whatever out
+    // held before is kept.
+    bool parse()
+    {
+        if (!parseSpecifiers() || !parseDeclarator(0))
+        {
+            return false;
+        }
+
+        if (lexer.peek().kind == TokenKind::SEMICOLON)
+        {
+            lexer.next();
+        }
+        else if (lexer.peek().kind == TokenKind::EQUALS)
+        {
+            lexer.restartAt(lexer.source().size());
+        }
+        if (lexer.peek().kind != TokenKind::END)
+        {
+            return unexpected(lexer.peek());
+        }
+
+        for (std::size_t i = 0; i < specifierCount; ++i)
+        {
+            if (i > 0)
+            {
+                out += ' ';
+            }
+            out += specifiers[i];
+        }
+        if (isTypedef)
+        {
+            typeNames.add(name);
+        }
+        return true;
+    }
+
+private:
+    enum class Derivation
+    {
+        NONE,
+        POINTER,
+        ARRAY,
+        FUNCTION
+    };
+
+    struct PointerLevel
     {
+        bool isConst = false;
+        bool isVolatile = false;
+        bool isRestrict = false;
+    };
 
-        return "Syntax error: Invalid identifier.";
+    static constexpr std::size_t maxSpecifiers = 8;
+    static constexpr std::size_t maxPointerLevels = 32;
+    static constexpr std::size_t maxNesting = 64;
+
+    bool fail(std::string_view message)
+    {
+        out.resize(start);
+        out += message;
+        return false;
     }
 
-    description += identifier + " as ";
+    bool unexpected(const Token &token)
+    {
+        if (token.kind == TokenKind::END)
+        {
+            return fail("Syntax error: unexpected end of declaration.");
+        }
+        fail("Syntax error: unexpected '");
+        out += token.text;
+        out += "'.";
+        return false;
+    }
 
-    if (!pointerPart.empty())
+    bool addSpecifier(std::string_view word)
     {
-        for (char p : pointerPart)
+        if (specifierCount == maxSpecifiers)
         {
-            if (p == '*')
+            return fail("Syntax error: too many type specifiers.");
+        }
+        specifiers[specifierCount++] = word;
+        return true;
+    }
+
+    bool parseSpecifiers()
+    {
+        bool sawType = false;
+        while (lexer.peek().kind == TokenKind::IDENTIFIER)
+        {
+            std::string_view word = lexer.peek().text;
+            SpecifierKind kind = classifySpecifier(word);
+            if (kind == SpecifierKind::NONE)
+            {
+                // The first unknown word after a type is the declarator's name.
+                if (sawType || !typeNames.contains(word))
+                {
+                    break;
+                }
+                sawType = true;
+            }
+            lexer.next();
+
+            if (kind == SpecifierKind::TYPEDEF)
+            {
+                isTypedef = true;
+                continue;
+            }
+            if (!addSpecifier(word))
+            {
+                return false;
+            }
+            if (kind == SpecifierKind::BASE_TYPE)
             {
-                description += "pointer to ";
+                sawType = true;
+            }
+            else if (kind == SpecifierKind::TAG)
+            {
+                if (lexer.peek().kind != TokenKind::IDENTIFIER)
+                {
+                    return unexpected(lexer.peek());
+                }
+                if (!addSpecifier(lexer.next().text))
+                {
+                    return false;
+                }
+                sawType = true;
             }
         }
+
+        if (!sawType)
+        {
+            return fail("Syntax error: Invalid base type.");
+        }
+        return true;
     }
 
-    std::regex arrayRegex("^\\[([0-9]*)\\]");
-    while (std::regex_search(input, match, arrayRegex))
+    bool parseDeclarator(std::size_t depth)
     {
-        std::string size = match[1].str();
-        if (size.empty())
+        std::array<PointerLevel, maxPointerLevels> pointers;
+        std::size_t pointerCount = 0;
+        while (lexer.peek().kind == TokenKind::STAR)
+        {
+            if (pointerCount == maxPointerLevels)
+            {
+                return fail("Syntax error: too many levels of pointers.");
+            }
+            lexer.next();
+            PointerLevel &level = pointers[pointerCount++];
+            level = PointerLevel{};
+            while (lexer.peek().kind == TokenKind::IDENTIFIER &&
+                   classifySpecifier(lexer.peek().text) == SpecifierKind::QUALIFIER)
+            {
+                std::string_view qualifier = lexer.next().text;
+                level.isConst |= qualifier == "const";
+                level.isVolatile |= qualifier == "volatile";
+                level.isRestrict |= qualifier == "restrict";
+            }
+        }
+
+        if (!parseDirectDeclarator(depth) || !parseSuffixes())
         {
-            arrayPart += "array of ";
+            return false;
         }
-        else
+
+        while (pointerCount > 0)
         {
-            arrayPart += "array of " + size + " elements of ";
+            const PointerLevel &level = pointers[--pointerCount];
+            if (level.isConst)
+            {
+                out += "const ";
+            }
+            if (level.isVolatile)
+            {
+                out += "volatile ";
+            }
+            if (level.isRestrict)
+            {
+                out += "restrict ";
+            }
+            out += "pointer to ";
+            last = Derivation::POINTER;
         }
-        input = match.suffix().str();
+        return true;
     }
-    if (!arrayPart.empty())
+
+    bool isDeclaratorName(const Token &token) const
     {
-        description += arrayPart;
+        return token.kind == TokenKind::IDENTIFIER && classifySpecifier(token.text) == SpecifierKind::NONE &&
+               !typeNames.contains(token.text);
     }
 
-    description += baseType;
+    bool parseDirectDeclarator(std::size_t depth)
+    {
+        const Token &token = lexer.peek();
+        if (isDeclaratorName(token))
+        {
+            name = token.text;
+            out += "declare ";
+            out += name;
+            out += isTypedef ? " as type " : " as ";
+            lexer.next();
+            return true;
+        }
+
+        // "(" opens a nested declarator only if one follows; otherwise it is a parameter list of a
+        // declarator that has no name.
+        Token second = lexer.peekSecond();
+        bool nested = second.kind == TokenKind::STAR || second.kind == TokenKind::LEFT_PAREN ||
+                      isDeclaratorName(second);
+        if (token.kind != TokenKind::LEFT_PAREN || !nested)
+        {
+            return fail("Syntax error: Invalid identifier.");
+        }
+        if (depth == maxNesting)
+        {
+            return fail("Syntax error: declarator nested too deeply.");
+        }
+
+        lexer.next();
+        if (!parseDeclarator(depth + 1))
+        {
+            return false;
+        }
+        if (lexer.peek().kind != TokenKind::RIGHT_PAREN)
+        {
+            return fail("Syntax error: missing ')'.");
+        }
+        lexer.next();
+        return true;
+    }
+
+    bool parseSuffixes()
+    {
+        while (true)
+        {
+            if (lexer.peek().kind == TokenKind::LEFT_BRACKET)
+            {
+                if (!parseArray())
+                {
+                    return false;
+                }
+            }
+            else if (lexer.peek().kind == TokenKind::LEFT_PAREN)
+            {
+                if (!parseFunction())
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                return true;
+            }
+        }
+    }
+
+    bool parseArray()
+    {
+        if (last == Derivation::FUNCTION)
+        {
+            return fail("Syntax error: a function cannot return an array.");
+        }
+        lexer.next();
+
+        std::string_view size;
+        if (lexer.peek().kind == TokenKind::NUMBER || lexer.peek().kind == TokenKind::IDENTIFIER)
+        {
+            size = lexer.next().text;
+        }
+        if (lexer.peek().kind != TokenKind::RIGHT_BRACKET)
+        {
+            return fail("Syntax error: missing ']'.");
+        }
+        lexer.next();
+
+        out += "array of ";
+        if (!size.empty())
+        {
+            out += size;
+            out += " elements of ";
+        }
+        last = Derivation::ARRAY;
+        return true;
+    }
+
+    // The parameter list is reported as written, so it is skipped by matching parentheses rather than
+    // parsed.
+    bool parseFunction()
+    {
+        if (last == Derivation::FUNCTION)
+        {
+            return fail("Syntax error: a function cannot return a function.");
+        }
+        if (last == Derivation::ARRAY)
+        {
+            return fail("Syntax error: an array cannot hold functions.");
+        }
+
+        std::string_view source = lexer.source();
+        std::size_t start = lexer.offset();
+        std::size_t end = start;
+        for (std::size_t depth = 1; end < source.size(); ++end)
+        {
+            if (source[end] == '(')
+            {
+                ++depth;
+            }
+            else if (source[end] == ')' && --depth == 0)
+            {
+                break;
+            }
+        }
+        if (end == source.size())
+        {
+            return fail("Syntax error: missing ')'.");
+        }
+        lexer.restartAt(end + 1);
+
+        std::string_view arguments = trimmed(source.substr(start, end - start));
+        out += "function";
+        if (!arguments.empty() && arguments != "void")
+        {
+            out += " accepting arguments: ";
+            appendCompacted(out, arguments);
+        }
+        out += " returning ";
+        last = Derivation::FUNCTION;
+        return true;
+    }
+
+    DeclarationLexer lexer;
+    TypeNames &typeNames;
+    std::string &out;
+    std::size_t start;
+    std::array<std::string_view, maxSpecifiers> specifiers;
+    std::size_t specifierCount = 0;
+    std::string_view name;
+    bool isTypedef = false;
+    Derivation last = Derivation::NONE;
+};
+
+// Appends to a caller-owned buffer. Reusing the buffer across lines means translation allocates nothing
+// once the buffer has grown to fit the longest description.
+void cdecl_translate(std::string_view declaration, TypeNames &typeNames, std::string &out)
+{
+    DeclarationParser parser(declaration, typeNames, out);
+    parser.parse();
+}
+
+std::string cdecl_translate(std::string_view declaration, TypeNames &typeNames)
+{
+    std::string description;
+    cdecl_translate(declaration, typeNames, description);
     return description;
 }
 
-void interpretFile(const std::string &filePath)
+std::string cdecl_translate(std::string_view declaration)
+{
+    TypeNames typeNames;
+    return cdecl_translate(declaration, typeNames);
+}
+
+struct DeclarationCacheStats
+{
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t bypasses = 0;
+    std::uint64_t evictions = 0;
+    double averageHitNanoseconds = 0;
+    double averageMissNanoseconds = 0;
+
+    double hitRate() const
+    {
+        std::uint64_t lookups = hits + misses;
+        return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+    }
+};
+
+// Bounded LRU of translations, split into independently locked shards so that parallel workers rarely
+// wait on each other. Entries are keyed on the whitespace-compacted declaration plus the fingerprint of
+// the typedef names in scope. Typedef lines are never cached because translating them updates the names.
+class DeclarationCache
+{
+public:
+    explicit DeclarationCache(std::size_t capacity = 1 << 16, std::size_t shardCount = 16)
+        : shards(std::max<std::size_t>(1, shardCount)),
+          shardCapacity(std::max<std::size_t>(1, capacity / std::max<std::size_t>(1, shardCount)))
+    {
+    }
+
+    // Appends the translation to out, like cdecl_translate. A hit allocates nothing.
+    void translate(std::string_view declaration, TypeNames &typeNames, std::string &out)
+    {
+        auto start = std::chrono::steady_clock::now();
+        if (declaration.find("typedef") != std::string_view::npos)
+        {
+            bypasses.fetch_add(1, std::memory_order_relaxed);
+            cdecl_translate(declaration, typeNames, out);
+            return;
+        }
+
+        // Per-thread scratch space, so building the key stops allocating after the first few lines.
+        static thread_local std::string key;
+        key.clear();
+        appendCompacted(key, declaration);
+        std::uint64_t fingerprint = typeNames.fingerprint();
+        key += '\0';
+        key.append(reinterpret_cast<const char *>(&fingerprint), sizeof(fingerprint));
+
+        std::size_t hash = std::hash<std::string_view>()(key);
+        Shard &shard = shards[hash % shards.size()];
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto found = shard.index.find(key);
+            if (found != shard.index.end())
+            {
+                shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+                out += found->second->second;
+                record(hits, hitNanoseconds, start);
+                return;
+            }
+        }
+
+        std::size_t descriptionStart = out.size();
+        cdecl_translate(declaration, typeNames, out);
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (shard.index.find(key) == shard.index.end())
+            {
+                shard.entries.emplace_front(key, out.substr(descriptionStart));
+                shard.index.emplace(shard.entries.front().first, shard.entries.begin());
+                if (shard.entries.size() > shardCapacity)
+                {
+                    shard.index.erase(shard.entries.back().first);
+                    shard.entries.pop_back();
+                    evictions.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+        record(misses, missNanoseconds, start);
+    }
+
+    std::string translate(std::string_view declaration, TypeNames &typeNames)
+    {
+        std::string description;
+        translate(declaration, typeNames, description);
+        return description;
+    }
+
+    DeclarationCacheStats stats() const
+    {
+        DeclarationCacheStats result;
+        result.hits = hits.load(std::memory_order_relaxed);
+        result.misses = misses.load(std::memory_order_relaxed);
+        result.bypasses = bypasses.load(std::memory_order_relaxed);
+        result.evictions = evictions.load(std::memory_order_relaxed);
+        if (result.hits > 0)
+        {
+            result.averageHitNanoseconds = static_cast<double>(hitNanoseconds.load()) / result.hits;
+        }
+        if (result.misses > 0)
+        {
+            result.averageMissNanoseconds = static_cast<double>(missNanoseconds.load()) / result.misses;
+        }
+        return result;
+    }
+
+private:
+    using Entry = std::pair<std::string, std::string>;
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::list<Entry> entries;
+        // Keys view the strings owned by the list nodes, which never move.
+        std::unordered_map<std::string_view, std::list<Entry>::iterator> index;
+    };
+
+    void record(std::atomic<std::uint64_t> &count, std::atomic<std::uint64_t> &nanoseconds,
+                std::chrono::steady_clock::time_point start)
+    {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        count.fetch_add(1, std::memory_order_relaxed);
+        nanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                              std::memory_order_relaxed);
+    }
+
+    std::vector<Shard> shards;
+    std::size_t shardCapacity;
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+    std::atomic<std::uint64_t> bypasses{0};
+    std::atomic<std::uint64_t> evictions{0};
+    std::atomic<std::uint64_t> hitNanoseconds{0};
+    std::atomic<std::uint64_t> missNanoseconds{0};
+};
+
+void cdecl_translate(std::string_view declaration, TypeNames &typeNames, std::string &out, DeclarationCache *cache)
+{
+    if (cache == nullptr)
+    {
+        cdecl_translate(declaration, typeNames, out);
+    }
+    else
+    {
+        cache->translate(declaration, typeNames, out);
+    }
+}
+
+void interpretFile(const std::string &filePath, std::ostream &out = std::cout, DeclarationCache *cache = nullptr)
 {
     std::ifstream file(filePath);
     if (!file.is_open())
@@ -142,25 +828,392 @@ void interpretFile(const std::string &filePath)
         return;
     }
 
+    TypeNames typeNames;
     std::string line;
+    std::string description;
     while (std::getline(file, line))
     {
-        std::cout << cdecl_translate(line) << std::endl;
+        description.clear();
+        cdecl_translate(line, typeNames, description, cache);
+        description += '\n';
+        out.write(description.data(), static_cast<std::streamsize>(description.size()));
     }
 
     file.close();
 }
 
+// Read-only mapping of a whole file. An empty file maps to an empty view.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile()
+    {
+        if (data != nullptr)
+        {
+            munmap(data, size);
+        }
+    }
+
+    bool open(const std::string &filePath)
+    {
+        int descriptor = ::open(filePath.c_str(), O_RDONLY);
+        if (descriptor < 0)
+        {
+            return false;
+        }
+        struct stat status;
+        if (fstat(descriptor, &status) != 0 || !S_ISREG(status.st_mode))
+        {
+            close(descriptor);
+            return false;
+        }
+
+        size = static_cast<std::size_t>(status.st_size);
+        if (size > 0)
+        {
+            void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (mapping == MAP_FAILED)
+            {
+                close(descriptor);
+                return false;
+            }
+            data = mapping;
+            madvise(data, size, MADV_SEQUENTIAL);
+        }
+        close(descriptor);
+        return true;
+    }
+
+    std::string_view contents() const
+    {
+        return data == nullptr ? std::string_view() : std::string_view(static_cast<const char *>(data), size);
+    }
+
+private:
+    void *data = nullptr;
+    std::size_t size = 0;
+};
+
+// Cuts text into about chunkCount pieces, each ending just after a newline (or at the end of the text).
+std::vector<std::string_view> splitIntoLineChunks(std::string_view text, std::size_t chunkCount)
+{
+    std::vector<std::string_view> chunks;
+    std::size_t target = std::max<std::size_t>(1, text.size() / std::max<std::size_t>(1, chunkCount));
+    std::size_t start = 0;
+    while (start < text.size())
+    {
+        std::size_t end = std::min(text.size(), start + target);
+        if (end < text.size())
+        {
+            std::size_t newline = text.find('\n', end - 1);
+            end = newline == std::string_view::npos ? text.size() : newline + 1;
+        }
+        chunks.push_back(text.substr(start, end - start));
+        start = end;
+    }
+    return chunks;
+}
+
+// Lines are split the way std::getline splits them: a final line without a newline still counts.
+void translateChunk(std::string_view chunk, TypeNames &typeNames, std::string &out, DeclarationCache *cache)
+{
+    while (!chunk.empty())
+    {
+        std::size_t newline = chunk.find('\n');
+        std::size_t length = newline == std::string_view::npos ? chunk.size() : newline;
+        cdecl_translate(chunk.substr(0, length), typeNames, out, cache);
+        out += '\n';
+        chunk.remove_prefix(std::min(chunk.size(), length + 1));
+    }
+}
+
+// Runs only the typedef lines of a chunk, so that the next chunk can start with the names a sequential
+// pass would already know.
+void registerTypedefs(std::string_view chunk, TypeNames &typeNames)
+{
+    std::size_t position = 0;
+    while ((position = chunk.find("typedef", position)) != std::string_view::npos)
+    {
+        std::size_t lineStart = chunk.rfind('\n', position);
+        lineStart = lineStart == std::string_view::npos ? 0 : lineStart + 1;
+        std::size_t lineEnd = chunk.find('\n', position);
+        lineEnd = lineEnd == std::string_view::npos ? chunk.size() : lineEnd;
+        cdecl_translate(chunk.substr(lineStart, lineEnd - lineStart), typeNames);
+        position = lineEnd;
+    }
+}
+
+// Same output as interpretFile, but the file is memory-mapped and cut into line-aligned chunks that
+// worker threads translate into their own buffers. Buffers are written in file order as soon as the
+// next one is ready.
+void interpretFileParallel(const std::string &filePath, std::ostream &out = std::cout, unsigned threadCount = 0,
+                           DeclarationCache *cache = nullptr)
+{
+    const std::size_t minChunkBytes = 1 << 16;
+
+    MappedFile file;
+    if (!file.open(filePath))
+    {
+        std::cerr << "Unable to open file: " << filePath << std::endl;
+        return;
+    }
+    std::string_view text = file.contents();
+
+    if (threadCount == 0)
+    {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::size_t chunkCount = std::min<std::size_t>(std::size_t(threadCount) * 4, text.size() / minChunkBytes + 1);
+    std::vector<std::string_view> chunks = splitIntoLineChunks(text, threadCount == 1 ? 1 : chunkCount);
+
+    std::vector<TypeNames> startingNames(chunks.size());
+    TypeNames knownNames;
+    for (std::size_t i = 0; i < chunks.size(); ++i)
+    {
+        startingNames[i] = knownNames;
+        if (i + 1 < chunks.size())
+        {
+            registerTypedefs(chunks[i], knownNames);
+        }
+    }
+
+    std::vector<std::promise<std::string>> results(chunks.size());
+    std::vector<std::future<std::string>> pending;
+    pending.reserve(chunks.size());
+    for (std::promise<std::string> &result : results)
+    {
+        pending.push_back(result.get_future());
+    }
+
+    std::atomic<std::size_t> nextChunk{0};
+    auto worker = [&]()
+    {
+        for (std::size_t i = nextChunk++; i < chunks.size(); i = nextChunk++)
+        {
+            try
+            {
+                std::string buffer;
+                buffer.reserve(chunks[i].size() * 3);
+                translateChunk(chunks[i], startingNames[i], buffer, cache);
+                results[i].set_value(std::move(buffer));
+            }
+            catch (...)
+            {
+                results[i].set_exception(std::current_exception());
+            }
+        }
+    };
+
+    std::vector<std::future<void>> workers;
+    for (std::size_t i = 0; i < std::min<std::size_t>(threadCount, chunks.size()); ++i)
+    {
+        workers.push_back(std::async(std::launch::async, worker));
+    }
+    for (std::future<std::string> &chunkOutput : pending)
+    {
+        std::string buffer = chunkOutput.get();
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    }
+}
+
+#ifdef EX5_COUNT_ALLOCATIONS
+// Benchmark builds only (-DEX5_COUNT_ALLOCATIONS): every global operator new is counted, so --bench can
+// report allocations per translated line. The replacements stay out of line; inlined, GCC takes the
+// malloc/free pairing for a new/free mismatch.
+std::atomic<std::uint64_t> &allocationCount()
+{
+    static std::atomic<std::uint64_t> count{0};
+    return count;
+}
+
+[[gnu::noinline]] void *operator new(std::size_t size)
+{
+    allocationCount().fetch_add(1, std::memory_order_relaxed);
+    if (void *memory = std::malloc(size == 0 ? 1 : size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+[[gnu::noinline]] void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+#endif
+
+class NullBuffer : public std::streambuf
+{
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char *, std::streamsize count) override { return count; }
+};
+
+bool writeBenchmarkCorpus(const std::string &filePath, std::size_t lines)
+{
+    const char *templates[] = {"char * a%zu;", "int ** b%zu;", "float d%zu[10];", "int (*func%zu)();", "int x%zu;",
+                               "invalid_declaration", "int r%zu[3][4];",
+                               "int (func%zu)(int*, int**, int***, float (*foo)(int*, char**));", "float t%zu[2][5][1]"};
+    std::ofstream file(filePath);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    char line[128];
+    for (std::size_t i = 0; i < lines; ++i)
+    {
+        std::snprintf(line, sizeof(line), templates[i % (sizeof(templates) / sizeof(templates[0]))], i % 1000);
+        file << line << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+// Runs translate over every line twice and counts the allocations of the second pass, which is the
+// steady state once buffers and caches have warmed up.
+#ifdef EX5_COUNT_ALLOCATIONS
+template <typename Translate>
+double allocationsPerLine(const std::vector<std::string> &lines, Translate translate)
+{
+    for (const std::string &line : lines)
+    {
+        translate(line);
+    }
+    std::uint64_t before = allocationCount().load();
+    for (const std::string &line : lines)
+    {
+        translate(line);
+    }
+    return static_cast<double>(allocationCount().load() - before) / static_cast<double>(lines.size());
+}
+#endif
+
+int runBenchmark()
+{
+    const std::size_t lines = 1000000;
+    std::string filePath = (std::filesystem::temp_directory_path() / "ex5_bench_declarations.txt").string();
+    if (!writeBenchmarkCorpus(filePath, lines))
+    {
+        std::cerr << "Unable to write benchmark file: " << filePath << std::endl;
+        return 1;
+    }
+
+    NullBuffer sink;
+    std::ostream discard(&sink);
+    auto start = std::chrono::steady_clock::now();
+    interpretFile(filePath, discard);
+    double sequential = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    start = std::chrono::steady_clock::now();
+    interpretFileParallel(filePath, discard, threads);
+    double parallel = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    DeclarationCache cache;
+    start = std::chrono::steady_clock::now();
+    interpretFile(filePath, discard, &cache);
+    double cached = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    DeclarationCacheStats sequentialStats = cache.stats();
+
+    DeclarationCache parallelCache;
+    start = std::chrono::steady_clock::now();
+    interpretFileParallel(filePath, discard, threads, &parallelCache);
+    double cachedParallel = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    DeclarationCacheStats parallelStats = parallelCache.stats();
+
+#ifdef EX5_COUNT_ALLOCATIONS
+    const std::size_t sampleLines = 100000;
+    std::vector<std::string> sample;
+    sample.reserve(sampleLines);
+    std::ifstream file(filePath);
+    for (std::string line; sample.size() < sampleLines && std::getline(file, line);)
+    {
+        sample.push_back(line);
+    }
+    file.close();
+
+    TypeNames typeNames;
+    std::string description;
+    std::size_t checksum = 0;
+    double returned = allocationsPerLine(sample, [&](const std::string &line)
+                                         { checksum += cdecl_translate(line, typeNames).size(); });
+    double buffered = allocationsPerLine(sample,
+                                         [&](const std::string &line)
+                                         {
+                                             description.clear();
+                                             cdecl_translate(line, typeNames, description);
+                                             checksum += description.size();
+                                         });
+    DeclarationCache sampleCache;
+    double cachedBuffered = allocationsPerLine(sample,
+                                               [&](const std::string &line)
+                                               {
+                                                   description.clear();
+                                                   sampleCache.translate(line, typeNames, description);
+                                                   checksum += description.size();
+                                               });
+#endif
+    std::filesystem::remove(filePath);
+
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << "interpretFile over " << lines << " declarations: " << lines / sequential << " lines/s" << std::endl;
+    std::cout << "interpretFileParallel with " << threads << " threads: " << lines / parallel << " lines/s"
+              << std::endl;
+    for (const auto &[label, seconds, stats] :
+         {std::tuple("interpretFile with cache", cached, sequentialStats),
+          std::tuple("interpretFileParallel with cache", cachedParallel, parallelStats)})
+    {
+        std::cout << std::setprecision(0) << label << ": " << lines / seconds << " lines/s, hit rate "
+                  << std::setprecision(2) << 100 * stats.hitRate() << "%, " << std::setprecision(0)
+                  << stats.averageHitNanoseconds << " ns/hit, " << stats.averageMissNanoseconds << " ns/miss"
+                  << std::endl;
+    }
+#ifdef EX5_COUNT_ALLOCATIONS
+    std::cout << std::setprecision(2) << "Allocations per line: " << returned << " returning std::string, "
+              << buffered << " into a reused buffer, " << cachedBuffered << " through the cache (checksum "
+              << checksum << ")" << std::endl;
+#else
+    std::cout << "Allocations per line: allocation counting disabled (build with -DEX5_COUNT_ALLOCATIONS)"
+              << std::endl;
+#endif
+    return 0;
+}
+
 int main(int argc, char *argv[])
 {
-    if (argc != 2)
+    if (argc != 2 && argc != 3)
     {
-        std::cerr << "Usage: " << argv[0] << " <file_path>" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " <file_path> [threads] | --bench" << std::endl;
         return 1;
     }
+    if (argc == 2 && std::string(argv[1]) == "--bench")
+    {
+        return runBenchmark();
+    }
 
     std::string filePath = argv[1];
-    interpretFile(filePath);
+    if (argc == 2)
+    {
+        interpretFile(filePath);
+        return 0;
+    }
+
+    char *end = nullptr;
+    unsigned long threads = std::strtoul(argv[2], &end, 10);
+    if (end == argv[2] || *end != '\0' || threads == 0 || threads > 1024)
+    {
+        std::cerr << "Invalid thread count: " << argv[2] << std::endl;
+        return 1;
+    }
+    interpretFileParallel(filePath, std::cout, static_cast<unsigned>(threads));
 
     return 0;
 }
\ No newline at end of file
@@ -3,104 +3,348 @@
 #include <initializer_list>
 #include <algorithm>
 #include <compare>
+#include <concepts>
 #include <iterator>
 #include <new>
+#include <vector>
+#include <memory>
+#include <cstddef>
 #include <sstream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <iomanip>
+#include <sys/mman.h>
+#include <unistd.h>
+
+size_t page_size()
+{
+    static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+size_t round_up_to_pages(size_t bytes)
+{
+    return (bytes + page_size() - 1) / page_size() * page_size();
+}
+
+// Largest element count whose size in bytes still fits in a size_t.
+constexpr size_t max_elements(size_t element_size)
+{
+    return std::numeric_limits<size_t>::max() / element_size;
+}
+
+// Growth policies pick the next capacity when an insertion needs more room than the vector has. They
+// saturate at max_elements instead of wrapping around.
+struct doubling_growth
+{
+    static size_t next_capacity(size_t capacity, size_t min_capacity, size_t element_size)
+    {
+        size_t limit = max_elements(element_size);
+        return std::max(min_capacity, capacity <= limit / 2 ? capacity * 2 : limit);
+    }
+};
+
+// Wastes less memory than doubling, and lets a freed block be reused by a later, larger allocation.
+struct one_and_half_growth
+{
+    static size_t next_capacity(size_t capacity, size_t min_capacity, size_t element_size)
+    {
+        size_t limit = max_elements(element_size);
+        return std::max(min_capacity, capacity <= limit - capacity / 2 ? capacity + capacity / 2 : limit);
+    }
+};
+
+// Doubles, then rounds the block up to whole pages once it spans at least one page. The rounded slack
+// would otherwise be wasted by mmap-backed allocations.
+struct page_rounded_growth
+{
+    static size_t next_capacity(size_t capacity, size_t min_capacity, size_t element_size)
+    {
+        size_t bytes = std::min(doubling_growth::next_capacity(capacity, min_capacity, element_size), max_elements(element_size)) * element_size;
+        if (bytes >= page_size() && bytes <= std::numeric_limits<size_t>::max() - (page_size() - 1))
+        {
+            bytes = round_up_to_pages(bytes);
+        }
+        return bytes / element_size;
+    }
+};
+
+// Allocators hand out raw bytes and throw std::bad_alloc on failure. A vector grows through
+// reallocate() only when the allocator offers it and the elements are trivially relocatable; otherwise it
+// allocates a new block, moves the elements over and frees the old one.
+struct new_allocator
+{
+    static constexpr bool can_reallocate = false;
+
+    static void *allocate(size_t bytes)
+    {
+        return ::operator new(bytes);
+    }
+
+    static void deallocate(void *memory, size_t)
+    {
+        ::operator delete(memory);
+    }
+};
+
+// Blocks below mmap_threshold live on the malloc heap and grow with realloc. Larger blocks are mapped
+// directly, and mremap grows them by moving page table entries instead of copying the contents.
+struct realloc_allocator
+{
+    static constexpr bool can_reallocate = true;
+    static constexpr size_t mmap_threshold = size_t(1) << 20;
+
+    static void *allocate(size_t bytes)
+    {
+        void *memory = nullptr;
+        if (bytes >= mmap_threshold)
+        {
+            memory = mmap(nullptr, round_up_to_pages(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            memory = memory == MAP_FAILED ? nullptr : memory;
+        }
+        else
+        {
+            memory = std::malloc(std::max<size_t>(bytes, 1));
+        }
+        if (memory == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return memory;
+    }
+
+    // Keeps the first used_bytes of the block; whatever lies beyond them is not preserved.
+    static void *reallocate(void *memory, size_t old_bytes, size_t used_bytes, size_t new_bytes)
+    {
+        bool was_mapped = old_bytes >= mmap_threshold;
+        bool is_mapped = new_bytes >= mmap_threshold;
+        void *result = nullptr;
+        if (was_mapped && is_mapped)
+        {
+            result = mremap(memory, round_up_to_pages(old_bytes), round_up_to_pages(new_bytes), MREMAP_MAYMOVE);
+            result = result == MAP_FAILED ? nullptr : result;
+        }
+        else if (!was_mapped && !is_mapped)
+        {
+            result = std::realloc(memory, std::max<size_t>(new_bytes, 1));
+        }
+        else
+        {
+            result = allocate(new_bytes);
+            std::memcpy(result, memory, std::min(used_bytes, new_bytes));
+            deallocate(memory, old_bytes);
+        }
+        if (result == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return result;
+    }
+
+    static void deallocate(void *memory, size_t bytes)
+    {
+        if (bytes >= mmap_threshold)
+        {
+            munmap(memory, round_up_to_pages(bytes));
+        }
+        else
+        {
+            std::free(memory);
+        }
+    }
+};
+
+// Whether a T can be moved to another address by copying its bytes and forgetting the original. Every
+// trivially copyable type can; specialize this for other types that hold no pointers into themselves.
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T>
+{
+};
 
+template <typename T, typename Allocator = new_allocator, typename GrowthPolicy = doubling_growth>
 class Vector
 {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Vector allocators only guarantee max_align_t alignment");
+
 private:
-    double *data_;
+    T *data_;
     size_t size_;
     size_t capacity_;
 
-    void check_index(size_t index) const
+    // The byte count of a larger block would wrap around, so it is rejected the way new T[count] would be.
+    static void check_length(size_t count, const char *caller)
     {
-        if (index >= size_)
+        if (count > max_size())
         {
-            throw std::out_of_range("Index out of bounds: " + std::to_string(index) + ", size: " + std::to_string(size_));
+            throw std::runtime_error("Memory allocation failed in " + std::string(caller) + ": " + std::string(std::bad_array_new_length().what()));
         }
     }
 
-    void ensure_capacity(size_t min_capacity)
+    static T *allocate_storage(size_t count, const char *caller)
     {
-        if (capacity_ < min_capacity)
+        if (count == 0)
         {
-            size_t new_capacity = std::max(min_capacity, capacity_ * 2);
-            reserve_internal(new_capacity);
+            return nullptr;
+        }
+        check_length(count, caller);
+        try
+        {
+            return static_cast<T *>(Allocator::allocate(count * sizeof(T)));
+        }
+        catch (const std::bad_alloc &e)
+        {
+            throw std::runtime_error("Memory allocation failed in " + std::string(caller) + ": " + std::string(e.what()));
         }
     }
 
-    void reserve_internal(size_t num)
+    static void release_storage(T *data, size_t capacity)
     {
-        if (num > capacity_)
+        if (data)
+        {
+            Allocator::deallocate(data, capacity * sizeof(T));
+        }
+    }
+
+    void release_storage()
+    {
+        release_storage(data_, capacity_);
+    }
+
+    // Moves the elements into a block of exactly num elements. Trivially relocatable elements are moved
+    // as bytes, through the allocator's reallocate() when it has one; others are move-constructed (or
+    // copied, if moving could throw) and the originals destroyed.
+    void relocate(size_t num, const char *caller)
+    {
+        if constexpr (Allocator::can_reallocate && is_trivially_relocatable<T>::value)
         {
-            double *new_data = nullptr;
-            try
+            if (data_)
             {
-                new_data = new double[num];
+                check_length(num, caller);
+                try
+                {
+                    data_ = static_cast<T *>(Allocator::reallocate(data_, capacity_ * sizeof(T), size_ * sizeof(T), num * sizeof(T)));
+                }
+                catch (const std::bad_alloc &e)
+                {
+                    throw std::runtime_error("Memory allocation failed in " + std::string(caller) + ": " + std::string(e.what()));
+                }
+                capacity_ = num;
+                return;
             }
-            catch (const std::bad_alloc &e)
+        }
+        T *new_data = allocate_storage(num, caller);
+        if (data_)
+        {
+            if constexpr (is_trivially_relocatable<T>::value)
             {
-                throw std::runtime_error("Memory allocation failed in reserve_internal: " + std::string(e.what()));
+                std::memcpy(static_cast<void *>(new_data), static_cast<const void *>(data_), size_ * sizeof(T));
             }
-            if (data_)
+            else
             {
-                std::copy(data_, data_ + size_, new_data);
-                delete[] data_;
+                try
+                {
+                    if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+                    {
+                        std::uninitialized_move(data_, data_ + size_, new_data);
+                    }
+                    else
+                    {
+                        std::uninitialized_copy(data_, data_ + size_, new_data);
+                    }
+                }
+                catch (...)
+                {
+                    release_storage(new_data, num);
+                    throw;
+                }
+                std::destroy_n(data_, size_);
             }
-            data_ = new_data;
-            capacity_ = num;
+            release_storage();
         }
+        data_ = new_data;
+        capacity_ = num;
     }
 
-public:
-    Vector() : data_(nullptr), size_(0), capacity_(0) {}
-
-    Vector(size_t count, double value) : size_(count), capacity_(count)
+    void check_index(size_t index) const
     {
-        try
-        {
-            data_ = new double[capacity_];
-        }
-        catch (const std::bad_alloc &e)
+        if (index >= size_)
         {
-            throw std::runtime_error("Memory allocation failed in Vector(size_t, double): " + std::string(e.what()));
+            throw std::out_of_range("Index out of bounds: " + std::to_string(index) + ", size: " + std::to_string(size_));
         }
-        std::fill(data_, data_ + size_, value);
     }
 
-    Vector(size_t count) : Vector(count, 0.0) {}
-
-    template <typename Iterator>
-    Vector(Iterator first, Iterator last)
+    void ensure_capacity(size_t min_capacity)
     {
-        size_ = std::distance(first, last);
-        capacity_ = size_;
-        try
+        if (capacity_ < min_capacity)
         {
-            data_ = new double[capacity_];
+            size_t new_capacity = GrowthPolicy::next_capacity(capacity_, min_capacity, sizeof(T));
+            reserve_internal(new_capacity);
         }
-        catch (const std::bad_alloc &e)
+    }
+
+    void reserve_internal(size_t num)
+    {
+        if (num > capacity_)
         {
-            throw std::runtime_error("Memory allocation failed in Vector(Iterator, Iterator): " + std::string(e.what()));
+            relocate(num, "reserve_internal");
         }
-        std::copy(first, last, data_);
     }
 
-    Vector(std::initializer_list<double> init) : Vector(init.begin(), init.end()) {}
+    // Takes ownership of storage whose first size elements the caller has already constructed.
+    Vector(T *data, size_t size, size_t capacity) : data_(data), size_(size), capacity_(capacity) {}
 
-    Vector(const Vector &other) : size_(other.size_), capacity_(other.capacity_)
+    template <typename Construct>
+    static Vector construct_into(size_t count, size_t capacity, const char *caller, Construct construct)
     {
+        T *data = allocate_storage(capacity, caller);
         try
         {
-            data_ = new double[capacity_];
+            construct(data);
         }
-        catch (const std::bad_alloc &e)
+        catch (...)
         {
-            throw std::runtime_error("Memory allocation failed in copy constructor: " + std::string(e.what()));
+            release_storage(data, capacity);
+            throw;
         }
-        std::copy(other.data_, other.data_ + other.size_, data_);
+        return Vector(data, count, capacity);
+    }
+
+public:
+    Vector() : data_(nullptr), size_(0), capacity_(0) {}
+
+    Vector(size_t count, const T &value)
+        : Vector(construct_into(count, count, "Vector(size_t, T)", [&](T *data)
+                                { std::uninitialized_fill_n(data, count, value); }))
+    {
+    }
+
+    Vector(size_t count)
+        : Vector(construct_into(count, count, "Vector(size_t)", [&](T *data)
+                                { std::uninitialized_value_construct_n(data, count); }))
+    {
+    }
+
+    // Constrained so that Vector<int>(5, 3) still means five threes.
+    template <typename Iterator>
+        requires std::derived_from<typename std::iterator_traits<Iterator>::iterator_category, std::forward_iterator_tag>
+    Vector(Iterator first, Iterator last)
+        : Vector(construct_into(static_cast<size_t>(std::distance(first, last)), static_cast<size_t>(std::distance(first, last)),
+                                "Vector(Iterator, Iterator)", [&](T *data)
+                                { std::uninitialized_copy(first, last, data); }))
+    {
+    }
+
+    Vector(std::initializer_list<T> init) : Vector(init.begin(), init.end()) {}
+
+    Vector(const Vector &other)
+        : Vector(construct_into(other.size_, other.capacity_, "copy constructor", [&](T *data)
+                                { std::uninitialized_copy(other.data_, other.data_ + other.size_, data); }))
+    {
     }
 
     Vector(Vector &&other) noexcept : data_(other.data_), size_(other.size_), capacity_(other.capacity_)
@@ -112,7 +356,8 @@ public:
 
     ~Vector()
     {
-        delete[] data_;
+        std::destroy_n(data_, size_);
+        release_storage();
     }
 
     Vector &operator=(const Vector &other)
@@ -123,19 +368,21 @@ public:
         }
         if (capacity_ < other.size_)
         {
-            delete[] data_;
-            capacity_ = other.size_;
-            try
-            {
-                data_ = new double[capacity_];
-            }
-            catch (const std::bad_alloc &e)
-            {
-                throw std::runtime_error("Memory allocation failed in copy assignment operator: " + std::string(e.what()));
-            }
+            Vector copy(construct_into(other.size_, other.size_, "copy assignment operator", [&](T *data)
+                                       { std::uninitialized_copy(other.data_, other.data_ + other.size_, data); }));
+            return *this = std::move(copy);
+        }
+        if (size_ >= other.size_)
+        {
+            std::copy(other.data_, other.data_ + other.size_, data_);
+            std::destroy(data_ + other.size_, data_ + size_);
+        }
+        else
+        {
+            std::copy(other.data_, other.data_ + size_, data_);
+            std::uninitialized_copy(other.data_ + size_, other.data_ + other.size_, data_ + size_);
         }
         size_ = other.size_;
-        std::copy(other.data_, other.data_ + size_, data_);
         return *this;
     }
 
@@ -145,7 +392,8 @@ public:
         {
             return *this;
         }
-        delete[] data_;
+        std::destroy_n(data_, size_);
+        release_storage();
         data_ = other.data_;
         size_ = other.size_;
         capacity_ = other.capacity_;
@@ -156,19 +404,19 @@ public:
         return *this;
     }
 
-    double &at(size_t index)
+    T &at(size_t index)
     {
         check_index(index);
         return data_[index];
     }
 
-    const double &at(size_t index) const
+    const T &at(size_t index) const
     {
         check_index(index);
         return data_[index];
     }
 
-    double &front()
+    T &front()
     {
         if (empty())
         {
@@ -177,7 +425,7 @@ public:
         return data_[0];
     }
 
-    const double &front() const
+    const T &front() const
     {
         if (empty())
         {
@@ -186,7 +434,7 @@ public:
         return data_[0];
     }
 
-    double &back()
+    T &back()
     {
         if (empty())
         {
@@ -195,7 +443,7 @@ public:
         return data_[size_ - 1];
     }
 
-    const double &back() const
+    const T &back() const
     {
         if (empty())
         {
@@ -204,12 +452,12 @@ public:
         return data_[size_ - 1];
     }
 
-    double *data()
+    T *data()
     {
         return data_;
     }
 
-    const double *data() const
+    const T *data() const
     {
         return data_;
     }
@@ -229,6 +477,11 @@ public:
         reserve_internal(num);
     }
 
+    static constexpr size_t max_size()
+    {
+        return max_elements(sizeof(T));
+    }
+
     size_t capacity() const
     {
         return capacity_;
@@ -240,43 +493,41 @@ public:
         {
             if (size_ == 0)
             {
-                delete[] data_;
+                release_storage();
                 data_ = nullptr;
                 capacity_ = 0;
             }
             else
             {
-                double *new_data = nullptr;
-                try
-                {
-                    new_data = new double[size_];
-                }
-                catch (const std::bad_alloc &e)
-                {
-                    throw std::runtime_error("Memory allocation failed in shrink_to_fit: " + std::string(e.what()));
-                }
-                std::copy(data_, data_ + size_, new_data);
-                delete[] data_;
-                data_ = new_data;
-                capacity_ = size_;
+                relocate(size_, "shrink_to_fit");
             }
         }
     }
 
     void clear()
     {
+        std::destroy_n(data_, size_);
         size_ = 0;
     }
 
-    void insert(size_t index, double elem)
+    // elem is taken by value, so it may refer to an element of this vector.
+    void insert(size_t index, T elem)
     {
         if (index > size_)
         {
             throw std::out_of_range("Index out of bounds for insert: " + std::to_string(index) + ", size: " + std::to_string(size_));
         }
         ensure_capacity(size_ + 1);
-        std::move_backward(data_ + index, data_ + size_, data_ + size_ + 1);
-        data_[index] = elem;
+        if (index == size_)
+        {
+            std::construct_at(data_ + size_, std::move(elem));
+        }
+        else
+        {
+            std::construct_at(data_ + size_, std::move(data_[size_ - 1]));
+            std::move_backward(data_ + index, data_ + size_ - 1, data_ + size_);
+            data_[index] = std::move(elem);
+        }
         ++size_;
     }
 
@@ -284,13 +535,35 @@ public:
     {
         check_index(index);
         std::move(data_ + index + 1, data_ + size_, data_ + index);
+        std::destroy_at(data_ + size_ - 1);
         --size_;
     }
 
-    void push_back(double elem)
+    template <typename... Args>
+    T &emplace_back(Args &&...args)
     {
-        ensure_capacity(size_ + 1);
-        data_[size_++] = elem;
+        if (size_ == capacity_)
+        {
+            // The arguments may refer to elements of the block that is about to move.
+            T elem(std::forward<Args>(args)...);
+            ensure_capacity(size_ + 1);
+            std::construct_at(data_ + size_, std::move(elem));
+        }
+        else
+        {
+            std::construct_at(data_ + size_, std::forward<Args>(args)...);
+        }
+        return data_[size_++];
+    }
+
+    void push_back(const T &elem)
+    {
+        emplace_back(elem);
+    }
+
+    void push_back(T &&elem)
+    {
+        emplace_back(std::move(elem));
     }
 
     void pop_back()
@@ -299,18 +572,39 @@ public:
         {
             throw std::underflow_error("pop_back() called on empty vector");
         }
+        std::destroy_at(data_ + size_ - 1);
         --size_;
     }
 
-    void resize(size_t new_size, double elem = 0.0)
+    void resize(size_t new_size)
+    {
+        if (new_size > size_)
+        {
+            reserve_internal(new_size);
+            std::uninitialized_value_construct(data_ + size_, data_ + new_size);
+        }
+        else
+        {
+            std::destroy(data_ + new_size, data_ + size_);
+        }
+        size_ = new_size;
+    }
+
+    void resize(size_t new_size, const T &elem)
     {
         if (new_size > capacity_)
         {
+            T value(elem);
             reserve_internal(new_size);
+            std::uninitialized_fill(data_ + size_, data_ + new_size, value);
         }
-        if (new_size > size_)
+        else if (new_size > size_)
+        {
+            std::uninitialized_fill(data_ + size_, data_ + new_size, elem);
+        }
+        else
         {
-            std::fill(data_ + size_, data_ + new_size, elem);
+            std::destroy(data_ + new_size, data_ + size_);
         }
         size_ = new_size;
     }
@@ -348,16 +642,16 @@ public:
     class iterator
     {
     private:
-        double *ptr_;
+        T *ptr_;
 
     public:
         using iterator_category = std::random_access_iterator_tag;
-        using value_type = double;
+        using value_type = T;
         using difference_type = std::ptrdiff_t;
-        using pointer = double *;
-        using reference = double &;
+        using pointer = T *;
+        using reference = T &;
 
-        iterator(double *ptr) : ptr_(ptr) {}
+        iterator(T *ptr) : ptr_(ptr) {}
 
         reference operator*() const
         {
@@ -478,8 +772,94 @@ public:
     }
 };
 
-int main()
+struct point
+{
+    double x;
+    double y;
+    double z;
+};
+
+struct employee
+{
+    std::string name;
+    int id;
+};
+
+template <typename Container, typename Make>
+void benchmark_push_back(const char *label, size_t count, Make make)
 {
+    try
+    {
+        auto start = std::chrono::steady_clock::now();
+        Container v;
+        size_t moves = 0;
+        const void *previous = nullptr;
+        for (size_t i = 0; i < count; ++i)
+        {
+            v.push_back(make(i));
+            if (v.data() != previous)
+            {
+                ++moves;
+                previous = v.data();
+            }
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << std::left << std::setw(34) << label << std::right << std::setw(12) << count << std::fixed
+                  << std::setprecision(3) << std::setw(10) << seconds << " s" << std::setprecision(2) << std::setw(8)
+                  << seconds * 1e9 / static_cast<double>(count) << " ns/elem" << std::setw(6) << moves << " moves"
+                  << std::setprecision(0) << std::setw(8) << static_cast<double>(v.capacity() * sizeof(*v.data())) / (1 << 20)
+                  << " MiB" << std::endl;
+    }
+    catch (const std::runtime_error &e)
+    {
+        std::cout << std::left << std::setw(34) << label << std::right << std::setw(12) << count << "  skipped: " << e.what() << std::endl;
+    }
+}
+
+int run_push_back_benchmark(size_t max_elements)
+{
+    auto make_double = [](size_t i)
+    { return static_cast<double>(i); };
+    for (size_t count = 1000000; count <= max_elements; count *= 10)
+    {
+        benchmark_push_back<Vector<double, new_allocator, doubling_growth>>("2x, new + copy", count, make_double);
+        benchmark_push_back<Vector<double, new_allocator, one_and_half_growth>>("1.5x, new + copy", count, make_double);
+        benchmark_push_back<Vector<double, new_allocator, page_rounded_growth>>("page-rounded, new + copy", count, make_double);
+        benchmark_push_back<Vector<double, realloc_allocator, doubling_growth>>("2x, realloc/mremap", count, make_double);
+        benchmark_push_back<Vector<double, realloc_allocator, one_and_half_growth>>("1.5x, realloc/mremap", count, make_double);
+        benchmark_push_back<Vector<double, realloc_allocator, page_rounded_growth>>("page-rounded, realloc/mremap", count, make_double);
+        std::cout << std::endl;
+    }
+
+    // point is relocated with memcpy (or mremap); std::string is not trivially relocatable in libstdc++,
+    // so it goes through its move constructor.
+    size_t element_count = std::min<size_t>(max_elements, 2000000);
+    auto make_point = [](size_t i)
+    { return point{static_cast<double>(i), 1.0, 2.0}; };
+    auto make_string = [](size_t i)
+    { return std::string(24, static_cast<char>('a' + i % 26)); };
+    benchmark_push_back<Vector<point>>("point, memcpy", element_count, make_point);
+    benchmark_push_back<Vector<point, realloc_allocator>>("point, realloc/mremap", element_count, make_point);
+    benchmark_push_back<std::vector<point>>("point, std::vector", element_count, make_point);
+    benchmark_push_back<Vector<std::string>>("std::string, move constructor", element_count, make_string);
+    benchmark_push_back<std::vector<std::string>>("std::string, std::vector", element_count, make_string);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1)
+    {
+        char *end = nullptr;
+        unsigned long long max_elements = argc == 3 ? std::strtoull(argv[2], &end, 10) : 100000000ull;
+        if (std::string(argv[1]) != "--bench" || argc > 3 || (argc == 3 && (end == argv[2] || *end != '\0')))
+        {
+            std::cerr << "Usage: " << argv[0] << " [--bench [max_elements]]" << std::endl;
+            return 1;
+        }
+        return run_push_back_benchmark(static_cast<size_t>(max_elements));
+    }
+
     try
     {
         Vector v = {1.0, 2.0, 3.0};
@@ -492,7 +872,7 @@ int main()
 
         std::cout << "Example of using front(): " << v.front() << std::endl;
 
-        Vector a = {};
+        Vector<double> a = {};
 
         std::cout << "Example of using back(): " << v.back() << std::endl;
 
@@ -546,7 +926,7 @@ int main()
         }
         std::cout << std::endl;
 
-        Vector v3;
+        Vector<double> v3;
         v3 = v;
         std::cout << "Vector v3 (copy assigned from v) elements: ";
         for (const auto &elem : v3)
@@ -564,7 +944,7 @@ int main()
         std::cout << std::endl;
         std::cout << "Vector v (after move construction) size: " << v.size() << std::endl;
 
-        Vector v5;
+        Vector<double> v5;
         v5 = std::move(v2);
         std::cout << "Vector v5 (move assigned from v2) elements: ";
         for (const auto &elem : v5)
@@ -574,6 +954,18 @@ int main()
         std::cout << std::endl;
         std::cout << "Vector v2 (after move assignment) size: " << v2.size() << std::endl;
 
+        Vector<employee> staff;
+        staff.emplace_back("Alice", 1);
+        staff.push_back({"Bob", 2});
+        staff.insert(0, employee{"Carol", 3});
+        staff.resize(4, staff.front());
+        std::cout << "Vector<employee> staff elements: ";
+        for (const auto &person : staff)
+        {
+            std::cout << person.name << "#" << person.id << " ";
+        }
+        std::cout << std::endl;
+
         return 0;
     }
     catch (const std::out_of_range &e)